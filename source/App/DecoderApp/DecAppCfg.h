@@ -71,6 +71,8 @@ protected:
   std::string   m_outputDecodedSEIMessagesFilename;   ///< filename to output decoded SEI messages to. If '-', then use stdout. If empty, do not output details.
   bool          m_bClipOutputVideoToRec709Range;      ///< If true, clip the output video to the Rec 709 range on saving.
   std::string   m_cacheCfgFile;                       ///< Config file of cache model
+  bool          m_mcFetchStats;                       ///< Report the reference fetches of the motion compensation per picture
+  bool          m_refPicPadding;                      ///< Pad the reference pictures, otherwise the motion compensation clamps the coordinates
 
 public:
   DecAppCfg();
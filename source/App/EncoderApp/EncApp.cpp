@@ -41,9 +41,13 @@
 #include <stdio.h>
 #include <fcntl.h>
 #include <iomanip>
+#include <sstream>
+#include <thread>
+#include <exception>
 
 #include "EncApp.h"
 #include "EncoderLib/AnnexBwrite.h"
+#include "Utilities/Parcat.h"
 #if EXTENSION_360_VIDEO
 #include "AppEncHelper360/TExt360AppEncTop.h"
 #endif
@@ -62,6 +66,9 @@ EncApp::EncApp()
   m_iFrameRcvd = 0;
   m_totalBytes = 0;
   m_essentialBytes = 0;
+  m_bitstreamOut = &m_bitstream;
+  m_segmentInput = nullptr;
+  m_segmentStart = 0;
 }
 
 EncApp::~EncApp()
@@ -230,6 +237,8 @@ void EncApp::xInitLibCfg()
 #if JVET_K0337_AFFINE_6PARA
   m_cEncLib.setAffineType                                        ( m_AffineType );
 #endif
+  m_cEncLib.setAffineAdaptiveSubblock                            ( m_AffineAdaptiveSubblock );
+  m_cEncLib.setFastAffineModel                                   ( m_FastAffineModel );
 #endif
 #if JVET_K0346 || JVET_K_AFFINE
   m_cEncLib.setHighPrecisionMv                                   (m_highPrecisionMv);
@@ -290,7 +299,9 @@ void EncApp::xInitLibCfg()
   }
   m_cEncLib.setUseConstrainedIntraPred                           ( m_bUseConstrainedIntraPred );
   m_cEncLib.setFastUDIUseMPMEnabled                              ( m_bFastUDIUseMPMEnabled );
+  m_cEncLib.setFastIntraModeDecision                             ( m_fastIntraModeDecision );
   m_cEncLib.setFastMEForGenBLowDelayEnabled                      ( m_bFastMEForGenBLowDelayEnabled );
+  m_cEncLib.setUseMEPreSearch                                    ( m_MEPreSearch );
   m_cEncLib.setUseBLambdaForNonKeyLowDelayPictures               ( m_bUseBLambdaForNonKeyLowDelayPictures );
   m_cEncLib.setPCMLog2MinSize                                    ( m_uiPCMLog2MinSize);
   m_cEncLib.setUsePCM                                            ( m_usePCM );
@@ -459,6 +470,7 @@ void EncApp::xInitLibCfg()
   m_cEncLib.setUseLCUSeparateModel                               ( m_RCUseLCUSeparateModel );
   m_cEncLib.setInitialQP                                         ( m_RCInitialQP );
   m_cEncLib.setForceIntraQP                                      ( m_RCForceIntraQP );
+  m_cEncLib.setUseRCLookahead                                    ( m_RCLookahead );
 #if U0132_TARGET_BITS_SATURATION
   m_cEncLib.setCpbSaturationEnabled                              ( m_RCCpbSaturationEnabled );
   m_cEncLib.setCpbSize                                           ( m_RCCpbSize );
@@ -541,12 +553,15 @@ void EncApp::xCreateLib( std::list<PelUnitBuf*>& recBufList
                         )
 {
   // Video I/O
-  m_cVideoIOYuvInputFile.open( m_inputFileName,     false, m_inputBitDepth, m_MSBExtendedBitDepth, m_internalBitDepth );  // read  mode
+  if( !m_segmentInput )
+  {
+    m_cVideoIOYuvInputFile.open( m_inputFileName,     false, m_inputBitDepth, m_MSBExtendedBitDepth, m_internalBitDepth );  // read  mode
 #if EXTENSION_360_VIDEO
-  m_cVideoIOYuvInputFile.skipFrames(m_FrameSkip, m_inputFileWidth, m_inputFileHeight, m_InputChromaFormatIDC);
+    m_cVideoIOYuvInputFile.skipFrames(m_FrameSkip, m_inputFileWidth, m_inputFileHeight, m_InputChromaFormatIDC);
 #else
-  m_cVideoIOYuvInputFile.skipFrames(m_FrameSkip, m_iSourceWidth - m_aiPad[0], m_iSourceHeight - m_aiPad[1], m_InputChromaFormatIDC);
+    m_cVideoIOYuvInputFile.skipFrames(m_FrameSkip, m_iSourceWidth - m_aiPad[0], m_iSourceHeight - m_aiPad[1], m_InputChromaFormatIDC);
 #endif
+  }
   if (!m_reconFileName.empty())
   {
     m_cVideoIOYuvReconFile.open(m_reconFileName, true, m_outputBitDepth, m_outputBitDepth, m_internalBitDepth);  // write mode
@@ -597,15 +612,193 @@ void EncApp::encode()
     EXIT( "Failed to open bitstream file " << m_bitstreamFileName.c_str() << " for writing\n");
   }
 
-  std::list<PelUnitBuf*> recBufList;
+  xInitEncoding();
+  xEncodeLoop();
+  xFinishEncoding();
+
+  m_bitstream.close();
+
+  printRateSummary();
+
+  return;
+}
+
+/**
+ - read the input pictures once into shared buffers
+ - split them into segments of one IDR period, each ending with the IDR picture that starts the next segment
+ - encode up to SegmentParallel segments concurrently, each with its own encoder instance
+ - concatenate the segment bitstreams in order with the parcat rules (JVET-B0036)
+ .
+ */
+void EncApp::encodeSegments( int argc, char* argv[] )
+{
+  m_bitstream.open(m_bitstreamFileName.c_str(), fstream::binary | fstream::out);
+  if (!m_bitstream)
+  {
+    EXIT( "Failed to open bitstream file " << m_bitstreamFileName.c_str() << " for writing\n");
+  }
+
+  // read the input pictures once
+  const InputColourSpaceConversion ipCSC = m_inputColourSpaceConvert;
+  const UnitArea unitArea( m_chromaFormatIDC, Area( 0, 0, m_iSourceWidth, m_iSourceHeight ) );
+  SegmentInput input;
+
+  m_cVideoIOYuvInputFile.open( m_inputFileName, false, m_inputBitDepth, m_MSBExtendedBitDepth, m_internalBitDepth );  // read  mode
+  m_cVideoIOYuvInputFile.skipFrames( m_FrameSkip, m_iSourceWidth - m_aiPad[0], m_iSourceHeight - m_aiPad[1], m_InputChromaFormatIDC );
+  while( (int)input.orgPics.size() < m_framesToBeEncoded )
+  {
+    PelStorage* orgPic     = new PelStorage;
+    PelStorage* trueOrgPic = new PelStorage;
+    orgPic    ->create( unitArea );
+    trueOrgPic->create( unitArea );
+    m_cVideoIOYuvInputFile.read( *orgPic, *trueOrgPic, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range );
+    if( m_cVideoIOYuvInputFile.isEof() )
+    {
+      delete orgPic;
+      delete trueOrgPic;
+      break;
+    }
+    input.orgPics    .push_back( orgPic );
+    input.trueOrgPics.push_back( trueOrgPic );
+    if( m_temporalSubsampleRatio > 1 )
+    {
+      m_cVideoIOYuvInputFile.skipFrames( m_temporalSubsampleRatio - 1, m_iSourceWidth - m_aiPad[0], m_iSourceHeight - m_aiPad[1], m_InputChromaFormatIDC );
+    }
+  }
+  m_cVideoIOYuvInputFile.close();
+  m_iFrameRcvd = (int)input.orgPics.size();
+
+  // segment k covers the pictures k * IntraPeriod to (k + 1) * IntraPeriod
+  std::vector<int> segmentStart;
+  for( int start = 0; start == 0 || start < m_iFrameRcvd - 1; start += m_iIntraPeriod )
+  {
+    segmentStart.push_back( start );
+  }
+  const int numSegments = (int)segmentStart.size();
+  msg( INFO, "\nSegment-parallel encoding of %d pictures in %d segments, %d concurrently\n", m_iFrameRcvd, numSegments, m_segmentParallel );
+
+  Parcat parcat;
+
+  for( int batchStart = 0; batchStart < numSegments; batchStart += m_segmentParallel )
+  {
+    const int batchSize = std::min( m_segmentParallel, numSegments - batchStart );
+    std::vector<EncApp*>               segmentApps( batchSize, nullptr );
+    std::vector<std::stringstream>     segmentStreams( batchSize );
+    std::vector<std::exception_ptr>    segmentErrors( batchSize );
+    std::vector<std::thread>           segmentThreads;
+
+    // configure and initialize the segment encoders sequentially
+    for( int i = 0; i < batchSize; i++ )
+    {
+      const int start  = segmentStart[batchStart + i];
+      const int length = std::min( start + m_iIntraPeriod + 1, m_iFrameRcvd ) - start;
+
+      std::vector<std::string> segmentArgs;
+      segmentArgs.push_back( "--SegmentParallel=0" );
+      segmentArgs.push_back( "--FrameSkip=" + std::to_string( m_FrameSkip + start * m_temporalSubsampleRatio ) );
+      segmentArgs.push_back( "--FramesToBeEncoded=" + std::to_string( length * m_temporalSubsampleRatio ) );
+      std::vector<char*> segmentArgv( argv, argv + argc );
+      for( auto &arg : segmentArgs )
+      {
+        segmentArgv.push_back( &arg[0] );
+      }
+
+      EncApp* app = new EncApp;
+      segmentApps[i] = app;
+      app->create();
+
+      // the configuration has already been reported, keep the segment parsers quiet
+      const MsgLevel verbosity = g_verbosity;
+      const bool ok = app->parseCfg( (int)segmentArgv.size(), &segmentArgv[0] );
+      g_verbosity   = verbosity;
+      if( !ok )
+      {
+        EXIT( "Failed to configure the encoder of segment " << batchStart + i );
+      }
+
+      app->m_segmentInput = &input;
+      app->m_segmentStart = start;
+      app->m_bitstreamOut = &segmentStreams[i];
+      app->xInitEncoding();
+    }
+
+    // encode the segments concurrently
+    for( int i = 0; i < batchSize; i++ )
+    {
+      segmentThreads.push_back( std::thread( [&segmentApps, &segmentErrors, i]()
+      {
+        try
+        {
+          segmentApps[i]->xEncodeLoop();
+        }
+        catch( ... )
+        {
+          segmentErrors[i] = std::current_exception();
+        }
+      } ) );
+    }
+    for( auto &t : segmentThreads )
+    {
+      t.join();
+    }
+    for( auto &e : segmentErrors )
+    {
+      if( e )
+      {
+        std::rethrow_exception( e );
+      }
+    }
+
+    // destroy the segment encoders and append the segments to the bitstream
+    for( int i = 0; i < batchSize; i++ )
+    {
+      EncApp* app = segmentApps[i];
+      msg( INFO, "\nSegment %d:", batchStart + i );
+      app->xFinishEncoding();
+      app->destroy();
+      delete app;
+
+      const std::string       str     = segmentStreams[i].str();
+      const std::vector<uint8_t> segment( str.begin(), str.end() );
+      const std::vector<uint8_t> out  = parcat.filterSegment( segment );
+      m_bitstream.write( reinterpret_cast<const char*>( out.data() ), out.size() );
+      m_totalBytes += (uint32_t)out.size();
+    }
+  }
+
+  for( size_t i = 0; i < input.orgPics.size(); i++ )
+  {
+    input.orgPics[i]    ->destroy();
+    input.trueOrgPics[i]->destroy();
+    delete input.orgPics[i];
+    delete input.trueOrgPics[i];
+  }
+
+  m_bitstream.close();
+
+  double time = (double) m_iFrameRcvd / m_iFrameRate * m_temporalSubsampleRatio;
+  msg( DETAILS,"\nBytes written to file: %u (%.3f kbps)\n", m_totalBytes, 0.008 * m_totalBytes / time );
+}
+
+void EncApp::xInitEncoding()
+{
   // initialize internal class & member variables
   xInitLibCfg();
-  xCreateLib( recBufList
+  xCreateLib( m_recBufList
              );
   xInitLib(m_isField);
 
   printChromaFormat();
 
+  const int sourceHeight = m_isField ? m_iSourceHeightOrg : m_iSourceHeight;
+  UnitArea unitArea( m_chromaFormatIDC, Area( 0, 0, m_iSourceWidth, sourceHeight ) );
+
+  m_orgPic.create( unitArea );
+  m_trueOrgPic.create( unitArea );
+}
+
+void EncApp::xEncodeLoop()
+{
   // main encoder loop
   int   iNumEncoded = 0;
   bool  bEos = false;
@@ -613,13 +806,8 @@ void EncApp::encode()
   const InputColourSpaceConversion ipCSC  =  m_inputColourSpaceConvert;
   const InputColourSpaceConversion snrCSC = (!m_snrInternalColourSpace) ? m_inputColourSpaceConvert : IPCOLOURSPACE_UNCHANGED;
 
-  PelStorage trueOrgPic;
-  PelStorage orgPic;
-  const int sourceHeight = m_isField ? m_iSourceHeightOrg : m_iSourceHeight;
-  UnitArea unitArea( m_chromaFormatIDC, Area( 0, 0, m_iSourceWidth, sourceHeight ) );
-
-  orgPic.create( unitArea );
-  trueOrgPic.create( unitArea );
+  PelStorage& trueOrgPic = m_trueOrgPic;
+  PelStorage& orgPic     = m_orgPic;
 #if EXTENSION_360_VIDEO
   TExt360AppEncTop           ext360(*this, m_cEncLib.getGOPEncoder()->getExt360Data(), *(m_cEncLib.getGOPEncoder()), orgPic);
 #endif
@@ -627,18 +815,26 @@ void EncApp::encode()
   while ( !bEos )
   {
     // read input YUV file
-#if EXTENSION_360_VIDEO
-    if (ext360.isEnabled())
+    if( m_segmentInput )
     {
-      ext360.read(m_cVideoIOYuvInputFile, orgPic, trueOrgPic, ipCSC);
+      orgPic    .copyFrom( *m_segmentInput->orgPics    [m_segmentStart + m_iFrameRcvd] );
+      trueOrgPic.copyFrom( *m_segmentInput->trueOrgPics[m_segmentStart + m_iFrameRcvd] );
     }
     else
     {
-      m_cVideoIOYuvInputFile.read(orgPic, trueOrgPic, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range);
-    }
+#if EXTENSION_360_VIDEO
+      if (ext360.isEnabled())
+      {
+        ext360.read(m_cVideoIOYuvInputFile, orgPic, trueOrgPic, ipCSC);
+      }
+      else
+      {
+        m_cVideoIOYuvInputFile.read(orgPic, trueOrgPic, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range);
+      }
 #else
-    m_cVideoIOYuvInputFile.read( orgPic, trueOrgPic, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range );
+      m_cVideoIOYuvInputFile.read( orgPic, trueOrgPic, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range );
 #endif
+    }
 
     // increase number of received frames
     m_iFrameRcvd++;
@@ -658,23 +854,23 @@ void EncApp::encode()
     // call encoding function for one frame
     if ( m_isField )
     {
-      m_cEncLib.encode( bEos, flush ? 0 : &orgPic, flush ? 0 : &trueOrgPic, snrCSC, recBufList,
+      m_cEncLib.encode( bEos, flush ? 0 : &orgPic, flush ? 0 : &trueOrgPic, snrCSC, m_recBufList,
                         iNumEncoded, m_isTopFieldFirst );
     }
     else
     {
-      m_cEncLib.encode( bEos, flush ? 0 : &orgPic, flush ? 0 : &trueOrgPic, snrCSC, recBufList,
+      m_cEncLib.encode( bEos, flush ? 0 : &orgPic, flush ? 0 : &trueOrgPic, snrCSC, m_recBufList,
                         iNumEncoded );
     }
 
     // write bistream to file if necessary
     if ( iNumEncoded > 0 )
     {
-      xWriteOutput( iNumEncoded, recBufList
+      xWriteOutput( iNumEncoded, m_recBufList
       );
     }
     // temporally skip frames
-    if( m_temporalSubsampleRatio > 1 )
+    if( m_temporalSubsampleRatio > 1 && !m_segmentInput )
     {
 #if EXTENSION_360_VIDEO
       m_cVideoIOYuvInputFile.skipFrames(m_temporalSubsampleRatio - 1, m_inputFileWidth, m_inputFileHeight, m_InputChromaFormatIDC);
@@ -683,26 +879,26 @@ void EncApp::encode()
 #endif
     }
   }
+}
 
+void EncApp::xFinishEncoding()
+{
   m_cEncLib.printSummary(m_isField);
 
 
   // delete used buffers in encoder class
   m_cEncLib.deletePicBuffer();
 
-  for( auto &p : recBufList )
+  for( auto &p : m_recBufList )
   {
     delete p;
   }
-  recBufList.clear();
-
-  xDestroyLib();
-
-  m_bitstream.close();
+  m_recBufList.clear();
 
-  printRateSummary();
+  m_orgPic.destroy();
+  m_trueOrgPic.destroy();
 
-  return;
+  xDestroyLib();
 }
 
 // ====================================================================================================================
@@ -758,9 +954,9 @@ void EncApp::xWriteOutput( int iNumEncoded, std::list<PelUnitBuf*>& recBufList
 
 void EncApp::outputAU( const AccessUnit& au )
 {
-  const vector<uint32_t>& stats = writeAnnexB(m_bitstream, au);
+  const vector<uint32_t>& stats = writeAnnexB(*m_bitstreamOut, au);
   rateStatsAccum(au, stats);
-  m_bitstream.flush();
+  m_bitstreamOut->flush();
 }
 
 
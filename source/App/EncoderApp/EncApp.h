@@ -40,6 +40,7 @@
 
 #include <list>
 #include <ostream>
+#include <vector>
 
 #include "EncoderLib/EncLib.h"
 #include "Utilities/VideoIOYuv.h"
@@ -53,6 +54,13 @@
 // Class definition
 // ====================================================================================================================
 
+/// source pictures read once and shared read-only by the segment encoders
+struct SegmentInput
+{
+  std::vector<PelStorage*> orgPics;
+  std::vector<PelStorage*> trueOrgPics;
+};
+
 /// encoder application class
 class EncApp : public EncAppCfg, public AUWriterIf
 {
@@ -65,6 +73,13 @@ private:
   uint32_t              m_essentialBytes;
   uint32_t              m_totalBytes;
   fstream           m_bitstream;
+  std::ostream*     m_bitstreamOut;               ///< output of the access units, the bitstream file or the segment buffer
+
+  std::list<PelUnitBuf*> m_recBufList;            ///< reconstruction buffers
+  PelStorage        m_orgPic;
+  PelStorage        m_trueOrgPic;
+  const SegmentInput* m_segmentInput;             ///< shared source pictures in segment-parallel mode
+  int               m_segmentStart;               ///< index of the first picture of the segment in m_segmentInput
 
 private:
   // initialization
@@ -74,6 +89,11 @@ private:
   void xInitLib    (bool isFieldCoding);         ///< initialize encoder class
   void xDestroyLib ();                           ///< destroy encoder class
 
+  // encoding phases
+  void xInitEncoding  ();                        ///< open files, create and initialize the encoder
+  void xEncodeLoop    ();                        ///< encode all pictures of the sequence or segment
+  void xFinishEncoding();                        ///< print the summary and destroy the encoder
+
   // file I/O
   void xWriteOutput     ( int iNumEncoded, std::list<PelUnitBuf*>& recBufList
                          );                      ///< write bitstream to file
@@ -86,6 +106,7 @@ public:
   virtual ~EncApp();
 
   void  encode();                               ///< main encoding function
+  void  encodeSegments( int argc, char* argv[] ); ///< segment-parallel encoding of the IDR periods
 
   void  outputAU( const AccessUnit& au );
 
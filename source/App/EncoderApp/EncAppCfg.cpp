@@ -768,6 +768,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("ClipOutputVideoToRec709Range",                    m_bClipOutputVideoToRec709Range,                  false, "If true then clip output video to the Rec. 709 Range on saving when OutputBitDepth is less than InternalBitDepth")
   ("SummaryOutFilename",                              m_summaryOutFilename,                          string(), "Filename to use for producing summary output file. If empty, do not produce a file.")
   ("SummaryPicFilenameBase",                          m_summaryPicFilenameBase,                      string(), "Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended. If empty, do not produce a file.")
+  ("ToolTimingReport",                                m_toolTimingReport,                            string(), "Filename of the JSON report of the run-time and call counts of the major coding tools. If empty, the tools are not timed.")
   ("SummaryVerboseness",                              m_summaryVerboseness,                                0u, "Specifies the level of the verboseness of the text output")
   ("Verbosity,v",                                     m_verbosity,                               (int)VERBOSE, "Specifies the level of the verboseness")
 
@@ -819,6 +820,8 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
 #if JVET_K0337_AFFINE_6PARA
   ( "AffineType",                                     m_AffineType,                                     2,  "Enable affine type prediction (0:off, 1:on)  [default: on] / [modify]  0:4param, 1:6param, 2:8param" )
 #endif
+  ("AffineAdaptiveSubblock",                          m_AffineAdaptiveSubblock,                        false, "Derive the affine MC sub-block size (4x4, 8x8 or 16x16) from the CPMV spread of each PU (0:off, 1:on)  [default: off]")
+  ("FastAffineModel",                                 m_FastAffineModel,                                   0, "Skip the affine and perspective ME based on the motion model chosen for the parent and co-located CUs (0:off, 1:perspective, 2:perspective and affine)  [default: off]")
 #endif
   ("DisableMotCompression",                           m_DisableMotionCompression,                       false, "Disable motion data compression for all modes")
 #if JVET_K0357_AMVR
@@ -1022,7 +1025,13 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
 
   ("ConstrainedIntraPred",                            m_bUseConstrainedIntraPred,                       false, "Constrained Intra Prediction")
   ("FastUDIUseMPMEnabled",                            m_bFastUDIUseMPMEnabled,                           true, "If enabled, adapt intra direction search, accounting for MPM")
+  ("FastIntraModeDecision",                           m_fastIntraModeDecision,                              0, "Gradient histogram based pre-selection of the intra luma modes tested with SATD\n"
+                                                                                                               "\t0: off\n"
+                                                                                                               "\t1: 4 gradient peaks and a grid of 9 angular modes\n"
+                                                                                                               "\t2: 2 gradient peaks and a grid of 5 angular modes\n"
+                                                                                                               "\t3: strongest gradient peak only, one mode less in the full RD check")
   ("FastMEForGenBLowDelayEnabled",                    m_bFastMEForGenBLowDelayEnabled,                   true, "If enabled use a fast ME for generalised B Low Delay slices")
+  ("MEPreSearch",                                     m_MEPreSearch,                                    false, "Seed the integer and affine motion search with a hierarchical pre-search on the downsampled source")
   ("UseBLambdaForNonKeyLowDelayPictures",             m_bUseBLambdaForNonKeyLowDelayPictures,            true, "Enables use of B-Lambda for non-key low-delay pictures")
   ("PCMEnabledFlag",                                  m_usePCM,                                         false)
   ("PCMLog2MaxSize",                                  m_pcmLog2MaxSize,                                    5u)
@@ -1083,6 +1092,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ( "RCLCUSeparateModel",                             m_RCUseLCUSeparateModel,                           true, "Rate control: use CTU level separate R-lambda model" )
   ( "InitialQP",                                      m_RCInitialQP,                                        0, "Rate control: initial QP" )
   ( "RCForceIntraQP",                                 m_RCForceIntraQP,                                 false, "Rate control: force intra QP to be equal to initial QP" )
+  ( "RCLookahead",                                    m_RCLookahead,                                    false, "Rate control: use a downsampled complexity pre-analysis for GOP/picture/CTU bit allocation (the lookahead window is limited to the pictures buffered for the current GOP)" )
 #if U0132_TARGET_BITS_SATURATION
   ( "RCCpbSaturation",                                m_RCCpbSaturationEnabled,                         false, "Rate control: enable target bits saturation to avoid CPB overflow and underflow" )
   ( "RCCpbSize",                                      m_RCCpbSize,                                         0u, "Rate control: CPB size" )
@@ -1271,6 +1281,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
 #else
   ("EnsureWppBitEqual",                               m_ensureWppBitEqual,                      false, "Ensure the results are equal to results with WPP-style parallelism, even if WPP is off")
 #endif
+  ("SegmentParallel",                                 m_segmentParallel,                            0, "Number of IDR periods encoded concurrently as independent segments and concatenated to one bitstream (0: off)")
 #if JVET_K0371_ALF
   ( "ALF",                                             m_alf,                                    true, "Adpative Loop Filter\n" )
 #endif
@@ -1987,6 +1998,16 @@ bool EncAppCfg::xCheckParameter()
   xConfirmPara( m_ensureWppBitEqual, "ENABLE_WPP_PARALLELISM is disabled, cannot ensure being WPP bit-equal" );
 #endif
 
+  xConfirmPara( m_FastAffineModel < 0 || m_FastAffineModel > 2,                             "FastAffineModel must be in the range of 0 to 2" );
+  xConfirmPara( m_segmentParallel < 0,                                                      "Number of parallel segments cannot be negative" );
+  if( m_segmentParallel > 0 )
+  {
+    xConfirmPara( m_iDecodingRefreshType != 2 || m_iIntraPeriod <= 0,                       "Segment-parallel encoding requires periodic IDR pictures (DecodingRefreshType 2 and IntraPeriod > 0)" );
+    xConfirmPara( m_isField,                                                                "Segment-parallel encoding does not support field coding" );
+    xConfirmPara( !m_reconFileName.empty(),                                                 "Segment-parallel encoding does not write a reconstruction file" );
+    xConfirmPara( !m_decodeBitstreams[0].empty() || !m_decodeBitstreams[1].empty(),         "Segment-parallel encoding cannot be combined with decoding of bitstreams" );
+  }
+
 
 #if SHARP_LUMA_DELTA_QP && ENABLE_QPA
   xConfirmPara( m_bUsePerceptQPA && m_lumaLevelToDeltaQPMapping.mode >= 2, "QPA and SharpDeltaQP mode 2 cannot be used together" );
@@ -2214,6 +2235,7 @@ bool EncAppCfg::xCheckParameter()
   xConfirmPara( m_loopFilterBetaOffsetDiv2 < -6 || m_loopFilterBetaOffsetDiv2 > 6,          "Loop Filter Beta Offset div. 2 exceeds supported range (-6 to 6)" );
   xConfirmPara( m_loopFilterTcOffsetDiv2 < -6 || m_loopFilterTcOffsetDiv2 > 6,              "Loop Filter Tc Offset div. 2 exceeds supported range (-6 to 6)" );
   xConfirmPara( m_iSearchRange < 0 ,                                                        "Search Range must be more than 0" );
+  xConfirmPara( m_fastIntraModeDecision < 0 || m_fastIntraModeDecision > 3,                 "FastIntraModeDecision must be in the range 0 to 3" );
   xConfirmPara( m_bipredSearchRange < 0 ,                                                   "Bi-prediction refinement search range must be more than 0" );
   xConfirmPara( m_minSearchWindow < 0,                                                      "Minimum motion search window size for the adaptive window ME must be greater than or equal to 0" );
   xConfirmPara( m_iMaxDeltaQP > MAX_DELTA_QP,                                               "Absolute Delta QP exceeds supported range (0 to 7)" );
@@ -3039,6 +3061,7 @@ void EncAppCfg::xPrintParameter()
     msg( DETAILS, "UseLCUSeparateModel                    : %d\n", m_RCUseLCUSeparateModel );
     msg( DETAILS, "InitialQP                              : %d\n", m_RCInitialQP );
     msg( DETAILS, "ForceIntraQP                           : %d\n", m_RCForceIntraQP );
+    msg( DETAILS, "RCLookahead                            : %d\n", m_RCLookahead );
 #if U0132_TARGET_BITS_SATURATION
     msg( DETAILS, "CpbSaturation                          : %d\n", m_RCCpbSaturationEnabled );
     if (m_RCCpbSaturationEnabled)
@@ -3063,6 +3086,8 @@ void EncAppCfg::xPrintParameter()
 #endif
   msg( VERBOSE, "SQP:%d ", m_uiDeltaQpRD                        );
   msg( VERBOSE, "ASR:%d ", m_bUseASR                            );
+  msg( VERBOSE, "MEPreSearch:%d ", m_MEPreSearch                );
+  msg( VERBOSE, "FastIntraMode:%d ", m_fastIntraModeDecision    );
   msg( VERBOSE, "MinSearchWindow:%d ", m_minSearchWindow        );
   msg( VERBOSE, "RestrictMESampling:%d ", m_bRestrictMESampling );
   msg( VERBOSE, "FEN:%d ", int(m_fastInterSearchMode)           );
@@ -3133,6 +3158,11 @@ void EncAppCfg::xPrintParameter()
       msg( VERBOSE, "AffineType:%d ", m_AffineType );
     }
 #endif
+    if ( m_Affine )
+    {
+      msg( VERBOSE, "AffineAdaptiveSubblock:%d ", m_AffineAdaptiveSubblock );
+      msg( VERBOSE, "FastAffineModel:%d ", m_FastAffineModel );
+    }
 #endif
 #if JVET_K0346
     msg(VERBOSE, "SubPuMvp:%d+%d ", m_SubPuMvpMode & 1, (m_SubPuMvpMode & 2) == 2);
@@ -3199,6 +3229,7 @@ void EncAppCfg::xPrintParameter()
   }
   msg( VERBOSE, "NumWppThreads:%d+%d ", m_numWppThreads, m_numWppExtraLines );
   msg( VERBOSE, "EnsureWppBitEqual:%d ", m_ensureWppBitEqual );
+  msg( VERBOSE, "SegmentParallel:%d ", m_segmentParallel );
 
 #if EXTENSION_360_VIDEO
   m_ext360.outputConfigurationSummary();
@@ -212,6 +212,8 @@ protected:
 #if JVET_K0337_AFFINE_6PARA
   int       m_AffineType;
 #endif
+  bool      m_AffineAdaptiveSubblock;
+  int       m_FastAffineModel;
 #endif
 #if JVET_K0346 || JVET_K_AFFINE
   bool      m_highPrecisionMv;
@@ -254,6 +256,7 @@ protected:
   int       m_numWppThreads;
   int       m_numWppExtraLines;
   bool      m_ensureWppBitEqual;
+  int       m_segmentParallel;                                ///< number of IDR periods encoded concurrently, 0: off
 
   // transfom unit (TU) definition
   int       m_quadtreeTULog2MaxSize;
@@ -346,7 +349,9 @@ protected:
 
   bool      m_bUseConstrainedIntraPred;                       ///< flag for using constrained intra prediction
   bool      m_bFastUDIUseMPMEnabled;
+  int       m_fastIntraModeDecision;                          ///< gradient based pre-selection of the intra modes (0: off, 1..3: increasing speed)
   bool      m_bFastMEForGenBLowDelayEnabled;
+  bool      m_MEPreSearch;                                    ///< hierarchical motion pre-search on the downsampled source
   bool      m_bUseBLambdaForNonKeyLowDelayPictures;
 
   HashType  m_decodedPictureHashSEIType;                      ///< Checksum mode for decoded picture hash SEI message
@@ -442,6 +447,7 @@ protected:
   bool      m_RCUseLCUSeparateModel;              ///< use separate R-lambda model at LCU level                        NOTE: code-tidy - rename to m_RCUseCtuSeparateModel
   int       m_RCInitialQP;                        ///< inital QP for rate control
   bool      m_RCForceIntraQP;                     ///< force all intra picture to use initial QP or not
+  bool      m_RCLookahead;                        ///< use lookahead complexity analysis of the buffered GOP for bit allocation
 #if U0132_TARGET_BITS_SATURATION
   bool      m_RCCpbSaturationEnabled;             ///< enable target bits saturation to avoid CPB overflow and underflow
   uint32_t      m_RCCpbSize;                          ///< CPB size
@@ -507,6 +513,7 @@ protected:
   std::string m_summaryOutFilename;                           ///< filename to use for producing summary output file.
   std::string m_summaryPicFilenameBase;                       ///< Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended.
   uint32_t        m_summaryVerboseness;                           ///< Specifies the level of the verboseness of the text output.
+  std::string m_toolTimingReport;                             ///< filename of the JSON tool timing report, empty: tools are not timed
 
   int         m_verbosity;
 
@@ -542,6 +549,9 @@ public:
   void  destroy   ();                                         ///< destroy option handling class
   bool  parseCfg  ( int argc, char* argv[] );                ///< parse configuration file to fill member variables
 
+  int   getSegmentParallel() const { return m_segmentParallel; }
+  const std::string& getToolTimingReport() const { return m_toolTimingReport; }
+
 };// END CLASS DEFINITION EncAppCfg
 
 //! \}
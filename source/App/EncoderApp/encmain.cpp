@@ -39,9 +39,11 @@
 #include <iostream>
 #include <chrono>
 #include <ctime>
+#include <fstream>
 
 #include "EncApp.h"
 #include "Utilities/program_options_lite.h"
+#include "CommonLib/ToolTimer.h"
 
 #include "svnrevision.h"
 
@@ -151,12 +153,21 @@ int main(int argc, char* argv[])
   fprintf(stdout, " started @ %s", std::ctime(&startTime2) );
   clock_t startClock = clock();
 
+  ToolTimer::setEnabled( !pcEncApp->getToolTimingReport().empty() );
+
   // call encoding function
 #ifndef _DEBUG
   try
   {
 #endif
-    pcEncApp->encode();
+    if( pcEncApp->getSegmentParallel() > 0 )
+    {
+      pcEncApp->encodeSegments( argc, argv );
+    }
+    else
+    {
+      pcEncApp->encode();
+    }
 #ifndef _DEBUG
   }
   catch( Exception &e )
@@ -175,6 +186,19 @@ int main(int argc, char* argv[])
   auto endTime = std::chrono::steady_clock::now();
   std::time_t endTime2 = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
   auto encTime = std::chrono::duration_cast<std::chrono::milliseconds>( endTime- startTime ).count();
+
+  if( ToolTimer::isEnabled() )
+  {
+    std::ofstream report( pcEncApp->getToolTimingReport() );
+    if( !report )
+    {
+      std::cerr << "Failed to open tool timing report " << pcEncApp->getToolTimingReport() << " for writing" << std::endl;
+    }
+    else
+    {
+      ToolTimer::writeReport( report, encTime / 1000.0 );
+    }
+  }
   // destroy application encoder class
   pcEncApp->destroy();
 
@@ -92,11 +92,13 @@ void InputBitstream::resetToStart()
 
 uint8_t* OutputBitstream::getByteStream() const
 {
+  xFlushHeldBytes();
   return (uint8_t*) &m_fifo.front();
 }
 
 uint32_t OutputBitstream::getByteStreamLength()
 {
+  xFlushHeldBytes();
   return uint32_t(m_fifo.size());
 }
 
@@ -112,43 +114,39 @@ void OutputBitstream::write   ( uint32_t uiBits, uint32_t uiNumberOfBits )
   CHECK( uiNumberOfBits > 32, "Number of bits is exceeds '32'" );
   CHECK( uiNumberOfBits != 32 && (uiBits & (~0 << uiNumberOfBits)) != 0, "Unsupported parameters" );
 
-  /* any modulo 8 remainder of num_total_bits cannot be written this time,
-   * and will be held until next time. */
-  uint32_t num_total_bits = uiNumberOfBits + m_num_held_bits;
-  uint32_t next_num_held_bits = num_total_bits % 8;
+  /* the bits are appended to the 64-bit accumulator, which is only
+   * flushed to the FIFO when the new bits would not fit any more.
+   * after a flush at most 7 bits are held, so 32 new bits always fit. */
+  if( m_num_held_bits + uiNumberOfBits > 64 )
+  {
+    xFlushHeldBytes();
+  }
 
-  /* form a byte aligned word (write_bits), by concatenating any held bits
-   * with the new bits, discarding the bits that will form the next_held_bits.
-   * eg: H = held bits, V = n new bits        /---- next_held_bits
-   * len(H)=7, len(V)=1: ... ---- HHHH HHHV . 0000 0000, next_num_held_bits=0
-   * len(H)=7, len(V)=2: ... ---- HHHH HHHV . V000 0000, next_num_held_bits=1
-   * if total_bits < 8, the value of v_ is not used */
-  uint8_t next_held_bits = uiBits << (8 - next_num_held_bits);
+  m_held_bits      = ( m_held_bits << uiNumberOfBits ) | uiBits;
+  m_num_held_bits += uiNumberOfBits;
+}
 
-  if (!(num_total_bits >> 3))
+void OutputBitstream::xFlushHeldBytes() const
+{
+  const uint32_t numBytes = m_num_held_bits >> 3;
+
+  if( numBytes == 0 )
   {
-    /* insufficient bits accumulated to write out, append new_held_bits to
-     * current held_bits */
-    /* NB, this requires that v only contains 0 in bit positions {31..n} */
-    m_held_bits |= next_held_bits;
-    m_num_held_bits = next_num_held_bits;
     return;
   }
 
-  /* topword serves to justify held_bits to align with the msb of uiBits */
-  uint32_t topword = (uiNumberOfBits - next_num_held_bits) & ~((1 << 3) -1);
-  uint32_t write_bits = (m_held_bits << topword) | (uiBits >> next_num_held_bits);
+  /* the bits below the last complete byte stay in the accumulator */
+  m_num_held_bits &= 7;
+  const uint64_t bytes = m_held_bits >> m_num_held_bits;
+  const size_t   pos   = m_fifo.size();
 
-  switch (num_total_bits >> 3)
+  m_fifo.resize( pos + numBytes );
+  for( uint32_t i = 0; i < numBytes; i++ )
   {
-  case 4: m_fifo.push_back(write_bits >> 24);
-  case 3: m_fifo.push_back(write_bits >> 16);
-  case 2: m_fifo.push_back(write_bits >> 8);
-  case 1: m_fifo.push_back(write_bits);
+    m_fifo[pos + i] = uint8_t( bytes >> ( 8 * ( numBytes - 1 - i ) ) );
   }
 
-  m_held_bits = next_held_bits;
-  m_num_held_bits = next_num_held_bits;
+  m_held_bits &= ( 1 << m_num_held_bits ) - 1;
 }
 
 void OutputBitstream::writeAlignOne()
@@ -160,11 +158,12 @@ void OutputBitstream::writeAlignOne()
 
 void OutputBitstream::writeAlignZero()
 {
+  xFlushHeldBytes();
   if (0 == m_num_held_bits)
   {
     return;
   }
-  m_fifo.push_back(m_held_bits);
+  m_fifo.push_back(uint8_t(m_held_bits << (8 - m_num_held_bits)));
   m_held_bits = 0;
   m_num_held_bits = 0;
 }
@@ -179,9 +178,24 @@ void   OutputBitstream::addSubstream( OutputBitstream* pcSubstream )
   uint32_t uiNumBits = pcSubstream->getNumberOfWrittenBits();
 
   const vector<uint8_t>& rbsp = pcSubstream->getFIFO();
-  for (vector<uint8_t>::const_iterator it = rbsp.begin(); it != rbsp.end();)
+  if (getNumBitsUntilByteAligned() == 0)
   {
-    write(*it++, 8);
+    // byte-aligned, the complete bytes are appended as they are
+    xFlushHeldBytes();
+    m_fifo.insert(m_fifo.end(), rbsp.begin(), rbsp.end());
+  }
+  else
+  {
+    const uint8_t* p   = rbsp.data();
+    const uint8_t* end = p + rbsp.size();
+    for (; end - p >= 4; p += 4)
+    {
+      write((uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3], 32);
+    }
+    for (; p != end; p++)
+    {
+      write(*p, 8);
+    }
   }
   if (uiNumBits&0x7)
   {
@@ -198,33 +212,42 @@ void OutputBitstream::writeByteAlignment()
 int OutputBitstream::countStartCodeEmulations()
 {
   uint32_t cnt = 0;
-  vector<uint8_t>& rbsp   = getFIFO();
-  for (vector<uint8_t>::iterator it = rbsp.begin(); it != rbsp.end();)
+  const vector<uint8_t>& rbsp = getFIFO();
+  const uint8_t*         end  = rbsp.data() + rbsp.size();
+  for (const uint8_t* found = findStartCodeEmulation(rbsp.data(), end); found != end; found = findStartCodeEmulation(found, end))
   {
-    vector<uint8_t>::iterator found = it;
-    do
+    cnt++;
+  }
+  return cnt;
+}
+
+const uint8_t* findStartCodeEmulation( const uint8_t* begin, const uint8_t* end )
+{
+  const uint8_t* p = begin;
+
+  // an emulation needs two zero bytes, which are rare in the payload, so the
+  // scan jumps from zero byte to zero byte with the vectorised memchr
+  while (end - p >= 3)
+  {
+    p = (const uint8_t*) memchr(p, 0, end - p - 2);
+    if (p == nullptr)
     {
-      // find the next emulated 00 00 {00,01,02,03}
-      // NB, end()-1, prevents finding a trailing two byte sequence
-      found = search_n(found, rbsp.end()-1, 2, 0);
-      found++;
-      // if not found, found == end, otherwise found = second zero byte
-      if (found == rbsp.end())
-      {
-        break;
-      }
-      if (*(++found) <= 3)
-      {
-        break;
-      }
-    } while (true);
-    it = found;
-    if (found != rbsp.end())
+      return end;
+    }
+    if (p[1] != 0)
+    {
+      p += 2;
+    }
+    else if (p[2] <= 3)
     {
-      cnt++;
+      return p + 2;
+    }
+    else
+    {
+      p += 3;
     }
   }
-  return cnt;
+  return end;
 }
 
 /**
@@ -321,6 +344,8 @@ void OutputBitstream::insertAt(const OutputBitstream& src, uint32_t pos)
 {
   CHECK(0 != src.getNumberOfWrittenBits() % 8, "Number of written bits is not a multiple of 8");
 
+  xFlushHeldBytes();
+  src.xFlushHeldBytes();
   vector<uint8_t>::iterator at = m_fifo.begin() + pos;
   m_fifo.insert(at, src.m_fifo.begin(), src.m_fifo.end());
 }
@@ -65,12 +65,19 @@ class OutputBitstream
    *  - fifo.clear() to empty the FIFO
    *  - &fifo.front() to get a pointer to the data array.
    *    NB, this pointer is only valid until the next push_back()/clear()
+   * The FIFO only holds the bytes flushed from the accumulator, which
+   * is done lazily by the accessors and is therefore allowed for const
+   * objects as well.
    */
-  std::vector<uint8_t> m_fifo;
+  mutable std::vector<uint8_t> m_fifo;
+
+  mutable uint32_t m_num_held_bits; /// number of bits not flushed to bytestream.
+  mutable uint64_t m_held_bits; /// the bits held and not flushed to bytestream.
+                             /// this value is lsb-aligned, up to 64 bits are accumulated.
+
+  /** move all complete bytes of the accumulator to the FIFO */
+  void        xFlushHeldBytes () const;
 
-  uint32_t m_num_held_bits; /// number of bits not flushed to bytestream.
-  uint8_t m_held_bits; /// the bits held and not flushed to bytestream.
-                             /// this value is always msb-aligned, bigendian.
 public:
   // create / destroy
   OutputBitstream();
@@ -125,13 +132,14 @@ public:
   /**
    * Return a reference to the internal fifo
    */
-  std::vector<uint8_t>& getFIFO() { return m_fifo; }
+  std::vector<uint8_t>& getFIFO() { xFlushHeldBytes(); return m_fifo; }
 
-  uint8_t getHeldBits  ()          { return m_held_bits;          }
+  /** Return the bits following the last complete byte, msb-aligned */
+  uint8_t getHeldBits  ()          { xFlushHeldBytes(); return uint8_t( m_held_bits << ( 8 - m_num_held_bits ) ); }
 
   //OutputBitstream& operator= (const OutputBitstream& src);
   /** Return a reference to the internal fifo */
-  const std::vector<uint8_t>& getFIFO() const { return m_fifo; }
+  const std::vector<uint8_t>& getFIFO() const { xFlushHeldBytes(); return m_fifo; }
 
   void          addSubstream    ( OutputBitstream* pcSubstream );
   void writeByteAlignment();
@@ -140,6 +148,15 @@ public:
   int countStartCodeEmulations();
 };
 
+/**
+ * Return the position of the next byte in [begin, end) that is preceded by
+ * two zero bytes and is equal to 0x00, 0x01, 0x02 or 0x03, i.e. the position
+ * before which an emulation_prevention_three_byte has to be inserted, or end
+ * if there is none. Scanning restarts with no zero bytes seen, so passing the
+ * returned position as the next begin finds all emulations of a payload.
+ */
+const uint8_t* findStartCodeEmulation( const uint8_t* begin, const uint8_t* end );
+
 /**
  * Model of an input bitstream that extracts bits from a predefined
  * bytestream.
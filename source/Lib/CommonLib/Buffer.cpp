@@ -42,6 +42,29 @@
 #include "Buffer.h"
 #include "InterpolationFilter.h"
 
+template<typename T>
+void paddingCore( T* ptr, int stride, int width, int height, int padW, int padH )
+{
+  T* p = ptr;
+
+  // left and right margins
+  for( int y = 0; y < height; y++, p += stride )
+  {
+    std::fill_n( p - padW,  padW, p[0] );
+    std::fill_n( p + width, padW, p[width - 1] );
+  }
+
+  // top and bottom margins as copies of the first and last extended rows
+  const T* top    = ptr - padW;
+  const T* bottom = ptr - padW + ( height - 1 ) * stride;
+
+  for( int y = 1; y <= padH; y++ )
+  {
+    ::memcpy( ( T* ) top    - y * stride, top,    sizeof( T ) * ( width + 2 * padW ) );
+    ::memcpy( ( T* ) bottom + y * stride, bottom, sizeof( T ) * ( width + 2 * padW ) );
+  }
+}
+
 #if ENABLE_SIMD_OPT_BUFFER
 #ifdef TARGET_SIMD_X86
 
@@ -103,6 +126,8 @@ PelBufferOps::PelBufferOps()
 
   linTf4 = linTfCore<Pel>;
   linTf8 = linTfCore<Pel>;
+
+  padding = paddingCore<Pel>;
 }
 
 PelBufferOps g_pelBufOP = PelBufferOps();
@@ -292,6 +317,18 @@ void AreaBuf<Pel>::linearTransform( const int scale, const int shift, const int
   }
 }
 
+template<>
+void AreaBuf<Pel>::extendBorderPel( unsigned marginX, unsigned marginY )
+{
+  CHECK( ( width + 2 * marginX ) > stride, "Size of buffer too small to extend" );
+
+#if ENABLE_SIMD_OPT_BUFFER && defined(TARGET_SIMD_X86)
+  g_pelBufOP.padding( buf, stride, width, height, marginX, marginY );
+#else
+  paddingCore( buf, stride, width, height, marginX, marginY );
+#endif
+}
+
 #if ENABLE_SIMD_OPT_BUFFER && defined(TARGET_SIMD_X86)
 template<>
 void AreaBuf<Pel>::subtract( const Pel val )
@@ -68,6 +68,7 @@ struct PelBufferOps
   void ( *reco8 )         ( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel *dst, int dstStride, int width, int height,                                   const ClpRng& clpRng );
   void ( *linTf4 )        ( const Pel* src0, int src0Stride,                                  Pel *dst, int dstStride, int width, int height, int scale, int shift, int offset, const ClpRng& clpRng, bool bClip );
   void ( *linTf8 )        ( const Pel* src0, int src0Stride,                                  Pel *dst, int dstStride, int width, int height, int scale, int shift, int offset, const ClpRng& clpRng, bool bClip );
+  void ( *padding )       (       Pel* ptr,  int stride,                                                      int width, int height, int padW, int padH );
 };
 
 extern PelBufferOps g_pelBufOP;
@@ -102,6 +103,7 @@ struct AreaBuf : public Size
   void subtract             ( const AreaBuf<const T> &other );
   void extendSingleBorderPel();
   void extendBorderPel      (  unsigned margin );
+  void extendBorderPel      (  unsigned marginX, unsigned marginY );
   void addAvg               ( const AreaBuf<const T> &other1, const AreaBuf<const T> &other2, const ClpRng& clpRng );
   void removeHighFreq       ( const AreaBuf<T>& other, const bool bClip, const ClpRng& clpRng);
   void updateHistogram      ( std::vector<int32_t>& hist ) const;
@@ -431,40 +433,47 @@ void AreaBuf<T>::updateHistogram( std::vector<int32_t>& hist ) const
 
 template<typename T>
 void AreaBuf<T>::extendBorderPel( unsigned margin )
+{
+  extendBorderPel( margin, margin );
+}
+
+template<typename T>
+void AreaBuf<T>::extendBorderPel( unsigned marginX, unsigned marginY )
 {
   T*  p = buf;
   int h = height;
   int w = width;
   int s = stride;
 
-  CHECK( ( w + 2 * margin ) > s, "Size of buffer too small to extend" );
+  CHECK( ( w + 2 * marginX ) > s, "Size of buffer too small to extend" );
   // do left and right margins
   for( int y = 0; y < h; y++ )
   {
-    for( int x = 0; x < margin; x++ )
-    {
-      *( p - margin + x ) = p[0];
-      p[w + x] = p[w - 1];
-    }
+    std::fill_n( p - marginX, marginX, p[0] );
+    std::fill_n( p + w,       marginX, p[w - 1] );
     p += s;
   }
 
   // p is now the (0,height) (bottom left of image within bigger picture
-  p -= ( s + margin );
-  // p is now the (-margin, height-1)
-  for( int y = 0; y < margin; y++ )
+  p -= ( s + marginX );
+  // p is now the (-marginX, height-1)
+  for( int y = 0; y < marginY; y++ )
   {
-    ::memcpy( p + ( y + 1 ) * s, p, sizeof( T ) * ( w + ( margin << 1 ) ) );
+    ::memcpy( p + ( y + 1 ) * s, p, sizeof( T ) * ( w + ( marginX << 1 ) ) );
   }
 
   // pi is still (-marginX, height-1)
   p -= ( ( h - 1 ) * s );
   // pi is now (-marginX, 0)
-  for( int y = 0; y < margin; y++ )
+  for( int y = 0; y < marginY; y++ )
   {
-    ::memcpy( p - ( y + 1 ) * s, p, sizeof( T ) * ( w + ( margin << 1 ) ) );
+    ::memcpy( p - ( y + 1 ) * s, p, sizeof( T ) * ( w + ( marginX << 1 ) ) );
   }
 }
+
+template<>
+void AreaBuf<Pel>::extendBorderPel( unsigned marginX, unsigned marginY );
+
 template<typename T>
 T AreaBuf<T>::meanDiff( const AreaBuf<const T> &other ) const
 {
@@ -100,6 +100,9 @@ CacheModel::CacheModel()
   m_missHitCountSeq   = 0;
   m_totalAccessSeq    = 0;
   m_frameCount        = 0;
+  m_affinePUs           = 0;
+  m_affineFetched       = 0;
+  m_affineSubblockFetch = 0;
 }
 
 CacheModel::~CacheModel()
@@ -280,6 +283,12 @@ void CacheModel::reportSequence( )
     fprintf( stdout, "Hit count / total %" PRIi64 " / %" PRIi64 "\n", m_hitCountSeq, m_totalAccessSeq );
 #endif
     fprintf( stdout, "Required bandwidth %.1f [MB] / frame\n", (((double)m_missHitCountSeq) * m_cacheLineSize) / (m_frameCount * 1024 * 1024) );
+    if ( m_affinePUs )
+    {
+      fprintf( stdout, "\nAffine MC reference footprint\n" );
+      fprintf( stdout, "PU predictions %lld\n", (long long) m_affinePUs );
+      fprintf( stdout, "Fetched samples %lld (sub-block wise %lld, %5.2f [%%])\n", (long long) m_affineFetched, (long long) m_affineSubblockFetch, ( 100 * (double) m_affineFetched ) / m_affineSubblockFetch );
+    }
   }
 }
 
@@ -427,6 +436,18 @@ void CacheModel::cacheAccess( const Pel *addr, const std::string& fileName, cons
   m_totalAccess++;
 }
 
+// account the reference samples of one affine PU prediction, fetched: samples read from the reference picture,
+// subblocks: samples the sub-block wise interpolation would have read
+void CacheModel::affineFetch( const int fetched, const int subblocks )
+{
+  if ( m_cacheEnable )
+  {
+    m_affinePUs++;
+    m_affineFetched       += fetched;
+    m_affineSubblockFetch += subblocks;
+  }
+}
+
 void CacheModel::setCacheEnable( bool enable )
 {
   m_cacheEnableFilter = enable;
@@ -45,10 +45,12 @@
 #define JVET_J0090_SET_CACHE_ENABLE( enable )          /* do nothing */
 #define JVET_J0090_SET_REF_PICTURE( refPic, compID )   /* do nothing */
 #define JVET_J0090_CACHE_ACCESS( src, fileName, line ) /* do nothing */
+#define JVET_J0090_AFFINE_FETCH( fetched, subblocks )  /* do nothing */
 #else
 #define JVET_J0090_SET_CACHE_ENABLE( enable )          m_cacheModel->setCacheEnable( enable )
 #define JVET_J0090_SET_REF_PICTURE( refPic, compID )   m_cacheModel->setRefPicture( refPic, compID )
 #define JVET_J0090_CACHE_ACCESS( src, fileName, line ) m_cacheModel->cacheAccess( src, fileName, line )
+#define JVET_J0090_AFFINE_FETCH( fetched, subblocks )  m_cacheModel->affineFetch( fetched, subblocks )
 
 
 
@@ -89,6 +91,10 @@ private:
   int64_t       m_missHitCountSeq;
   int64_t       m_totalAccessSeq;
   int           m_frameCount;
+  // reference footprint of the affine MC
+  int64_t       m_affinePUs;           // # of affine PU predictions (per component)
+  int64_t       m_affineFetched;       // reference samples fetched (prefetch tile or sub-block wise)
+  int64_t       m_affineSubblockFetch; // reference samples of the sub-block wise interpolation
 
 public:
   CacheModel();
@@ -103,6 +109,7 @@ public:
   void accumulateFrame( );
   void setCacheEnable( bool enable );
   void setRefPicture( const Picture *refPic, const ComponentID compID );
+  void affineFetch( const int fetched, const int subblocks );
 
 protected:
   bool xIsCacheHit( int pos, size_t addr );
@@ -84,6 +84,9 @@ CodingStructure::CodingStructure(CUCache& cuCache, PUCache& puCache, TUCache& tu
   }
 
   m_motionBuf     = nullptr;
+#if ENABLE_COMPRESSED_COL_MOTION
+  m_colMotionValid = false;
+#endif
   features.resize( NUM_ENC_FEATURES );
 
 }
@@ -117,6 +120,10 @@ void CodingStructure::destroy()
 
   delete[] m_motionBuf;
   m_motionBuf = nullptr;
+#if ENABLE_COMPRESSED_COL_MOTION
+  m_colMotion.clear();
+  m_colMotionValid = false;
+#endif
 
 
   m_tuCache.cache( tus );
@@ -988,6 +995,13 @@ void CodingStructure::initStructData( const int &QP, const bool &_isLosses, cons
   {
     getMotionBuf()      .memset( 0 );
   }
+#if ENABLE_COMPRESSED_COL_MOTION
+
+  if( !parent )
+  {
+    m_colMotionValid = false;
+  }
+#endif
 
   fracBits = 0;
   dist     = 0;
@@ -1103,6 +1117,54 @@ const MotionInfo& CodingStructure::getMotionInfo( const Position& pos ) const
   return *( m_motionBuf + miPos.y * stride + miPos.x );
 }
 
+#if ENABLE_COMPRESSED_COL_MOTION
+static const unsigned COL_MOTION_SCALE = 4 * std::max<int>( 1, 4 * AMVP_DECIMATION_FACTOR / 4 );
+
+#endif
+void CodingStructure::compressColMotion()
+{
+#if ENABLE_COMPRESSED_COL_MOTION
+  // the collocated fetches only ever touch the top-left motion info of each COL_MOTION_SCALE x COL_MOTION_SCALE block,
+  // gather those into a dense array so that they do not drag the full resolution motion field through the caches
+  const unsigned stride     = g_miScaling.scaleHor( area.lumaSize().width );
+  const unsigned step       = g_miScaling.scaleHor( COL_MOTION_SCALE );
+  const unsigned colWidth   = ( area.lumaSize().width  + COL_MOTION_SCALE - 1 ) / COL_MOTION_SCALE;
+  const unsigned colHeight  = ( area.lumaSize().height + COL_MOTION_SCALE - 1 ) / COL_MOTION_SCALE;
+
+  m_colMotion.resize( colWidth * colHeight );
+
+  MotionInfo* dst = m_colMotion.data();
+
+  for( unsigned y = 0; y < colHeight; y++ )
+  {
+    const MotionInfo* src = m_motionBuf + y * step * stride;
+
+    for( unsigned x = 0; x < colWidth; x++, src += step )
+    {
+      *dst++ = *src;
+    }
+  }
+
+  m_colMotionValid = true;
+#endif
+}
+
+const MotionInfo& CodingStructure::getColMotionInfo( const Position& pos ) const
+{
+#if ENABLE_COMPRESSED_COL_MOTION
+  if( m_colMotionValid )
+  {
+    CHECKD( !area.Y().contains( pos ), "Trying to access motion information outside of this coding structure" );
+    CHECKD( ( ( pos.x - area.lx() ) | ( pos.y - area.ly() ) ) & ( COL_MOTION_SCALE - 1 ), "Collocated motion has to be fetched on the motion compression grid" );
+
+    const unsigned colWidth = ( area.lumaSize().width + COL_MOTION_SCALE - 1 ) / COL_MOTION_SCALE;
+
+    return m_colMotion[unsigned( pos.y - area.ly() ) / COL_MOTION_SCALE * colWidth + unsigned( pos.x - area.lx() ) / COL_MOTION_SCALE];
+  }
+#endif
+  return getMotionInfo( pos );
+}
+
 
 // data accessors
        PelBuf     CodingStructure::getPredBuf(const CompArea &blk)           { return getBuf(blk,  PIC_PREDICTION); }
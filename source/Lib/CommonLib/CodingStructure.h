@@ -211,6 +211,10 @@ private:
   int     m_offsets[ MAX_NUM_COMPONENT ];
 
   MotionInfo *m_motionBuf;
+#if ENABLE_COMPRESSED_COL_MOTION
+  std::vector<MotionInfo> m_colMotion;
+  bool                    m_colMotionValid;
+#endif
 
 public:
 
@@ -225,6 +229,10 @@ public:
   MotionInfo& getMotionInfo( const Position& pos );
   const MotionInfo& getMotionInfo( const Position& pos ) const;
 
+  // collocated (TMVP/ATMVP) access to the motion of a finished picture, pos has to lie on the motion compression grid
+  void compressColMotion();
+  const MotionInfo& getColMotionInfo( const Position& pos ) const;
+
 
 public:
   // ---------------------------------------------------------------------------
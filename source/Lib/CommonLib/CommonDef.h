@@ -331,6 +331,8 @@ static const int AFFINE_MAX_NUM_V2 =                                2; ///< max
 static const int AFFINE_MAX_NUM_V3 =								1; ///< max number of motion candidates in right-bottom corner
 static const int AFFINE_MAX_NUM_COMB =                             12; ///< max number of combined motion candidates
 static const int AFFINE_MIN_BLOCK_SIZE =                            4; ///< Minimum affine MC block size
+static const int AFFINE_MAX_BLOCK_SIZE =                           16; ///< Maximum affine MC block size of the adaptive sub-block size derivation
+static const int AFFINE_REF_TILE_SIZE =           2 * MAX_CU_SIZE + 8; ///< Maximum width and height of the prefetched reference footprint of an affine PU
 #endif
 
 #if W0038_DB_OPT
@@ -55,6 +55,7 @@ InterPrediction::InterPrediction()
   m_currChromaFormat( NUM_CHROMA_FORMAT )
 , m_maxCompIDToPred ( MAX_NUM_COMPONENT )
 , m_pcRdCost        ( nullptr )
+, m_fetchStats      ( nullptr )
 {
   for( uint32_t ch = 0; ch < MAX_NUM_COMPONENT; ch++ )
   {
@@ -76,7 +77,11 @@ InterPrediction::InterPrediction()
       m_filteredBlockTmp[i][c] = nullptr;
     }
   }
+#if JVET_K_AFFINE && ENABLE_AFFINE_MC_REF_TILE
 
+  m_affineRefTile = nullptr;
+#endif
+  m_refFetchBuf   = nullptr;
 }
 
 InterPrediction::~InterPrediction()
@@ -109,7 +114,13 @@ void InterPrediction::destroy()
       m_filteredBlockTmp[i][c] = nullptr;
     }
   }
+#if JVET_K_AFFINE && ENABLE_AFFINE_MC_REF_TILE
 
+  xFree( m_affineRefTile );
+  m_affineRefTile = nullptr;
+#endif
+  xFree( m_refFetchBuf );
+  m_refFetchBuf = nullptr;
 }
 
 void InterPrediction::init( RdCost* pcRdCost, ChromaFormat chromaFormatIDC )
@@ -147,6 +158,11 @@ void InterPrediction::init( RdCost* pcRdCost, ChromaFormat chromaFormatIDC )
         m_acYuvPred[i][c] = ( Pel* ) xMalloc( Pel, MAX_CU_SIZE * MAX_CU_SIZE );
       }
     }
+#if JVET_K_AFFINE && ENABLE_AFFINE_MC_REF_TILE
+
+    m_affineRefTile = ( Pel* ) xMalloc( Pel, AFFINE_REF_TILE_SIZE * AFFINE_REF_TILE_SIZE );
+#endif
+    m_refFetchBuf   = ( Pel* ) xMalloc( Pel, ( MAX_CU_SIZE + NTAPS_LUMA ) * ( MAX_CU_SIZE + NTAPS_LUMA ) );
 
     m_iRefListIdx = -1;
     
@@ -187,17 +203,17 @@ bool checkIdenticalMotion( const PredictionUnit &pu )
         else
         {
           CHECK( !checkAffine, "In this case, checkAffine should be on." );
-          const CMotionBuf &mb = pu.getMotionBuf();
+          const Mv ( &cpmv )[NUM_REF_PIC_LIST_01][4] = pu.mvAffi;
 #if JVET_K_AFFINE_BUG_FIXES
 #if JVET_K0337_AFFINE_6PARA
-          if ( (pu.cu->affineType == AFFINEMODEL_4PARAM && (mb.at( 0, 0 ).mv[0] == mb.at( 0, 0 ).mv[1]) && (mb.at( mb.width - 1, 0 ).mv[0] == mb.at( mb.width - 1, 0 ).mv[1]))
-            || (pu.cu->affineType == AFFINEMODEL_6PARAM && (mb.at( 0, 0 ).mv[0] == mb.at( 0, 0 ).mv[1]) && (mb.at( mb.width - 1, 0 ).mv[0] == mb.at( mb.width - 1, 0 ).mv[1]) && (mb.at( 0, mb.height - 1 ).mv[0] == mb.at( 0, mb.height - 1 ).mv[1])) 
-			|| (pu.cu->affineType == AFFINEMODEL_8PARAM && (mb.at( 0, 0 ).mv[0] == mb.at( 0, 0 ).mv[1]) && (mb.at( mb.width - 1, 0 ).mv[0] == mb.at( mb.width - 1, 0 ).mv[1]) && (mb.at( 0, mb.height - 1 ).mv[0] == mb.at( 0, mb.height - 1 ).mv[1])) )
+          if ( (pu.cu->affineType == AFFINEMODEL_4PARAM && (cpmv[0][0] == cpmv[1][0]) && (cpmv[0][1] == cpmv[1][1]))
+            || (pu.cu->affineType == AFFINEMODEL_6PARAM && (cpmv[0][0] == cpmv[1][0]) && (cpmv[0][1] == cpmv[1][1]) && (cpmv[0][2] == cpmv[1][2])) 
+			|| (pu.cu->affineType == AFFINEMODEL_8PARAM && (cpmv[0][0] == cpmv[1][0]) && (cpmv[0][1] == cpmv[1][1]) && (cpmv[0][2] == cpmv[1][2])) )
 #else
-          if ( (mb.at( 0, 0 ).mv[0] == mb.at( 0, 0 ).mv[1]) && (mb.at( mb.width - 1, 0 ).mv[0] == mb.at( mb.width - 1, 0 ).mv[1]) )
+          if ( (cpmv[0][0] == cpmv[1][0]) && (cpmv[0][1] == cpmv[1][1]) )
 #endif
 #else
-          if( ( mb.at( 0, 0 ).mv[0] == mb.at( 0, 0 ).mv[1] ) && ( mb.at( mb.width - 1, 0 ).mv[0] == mb.at( mb.width - 1, 0 ).mv[1] ) && ( mb.at( 0, mb.height - 1 ).mv[0] == mb.at( 0, mb.height - 1 ).mv[1] ) )
+          if( ( cpmv[0][0] == cpmv[1][0] ) && ( cpmv[0][1] == cpmv[1][1] ) && ( cpmv[0][2] == cpmv[1][2] ) )
 #endif
           {
             return true;
@@ -240,17 +256,17 @@ bool InterPrediction::xCheckIdenticalMotion( const PredictionUnit &pu )
 #if JVET_K_AFFINE
         else
         {
-          const CMotionBuf &mb = pu.getMotionBuf();
+          const Mv ( &cpmv )[NUM_REF_PIC_LIST_01][4] = pu.mvAffi;
 #if JVET_K_AFFINE_BUG_FIXES
 #if JVET_K0337_AFFINE_6PARA
-          if ( (pu.cu->affineType == AFFINEMODEL_4PARAM && (mb.at( 0, 0 ).mv[0] == mb.at( 0, 0 ).mv[1]) && (mb.at( mb.width - 1, 0 ).mv[0] == mb.at( mb.width - 1, 0 ).mv[1]))
-            || (pu.cu->affineType == AFFINEMODEL_6PARAM && (mb.at( 0, 0 ).mv[0] == mb.at( 0, 0 ).mv[1]) && (mb.at( mb.width - 1, 0 ).mv[0] == mb.at( mb.width - 1, 0 ).mv[1]) && (mb.at( 0, mb.height - 1 ).mv[0] == mb.at( 0, mb.height - 1 ).mv[1])) 
-			|| (pu.cu->affineType == AFFINEMODEL_8PARAM && (mb.at( 0, 0 ).mv[0] == mb.at( 0, 0 ).mv[1]) && (mb.at( mb.width - 1, 0 ).mv[0] == mb.at( mb.width - 1, 0 ).mv[1]) && (mb.at( 0, mb.height - 1 ).mv[0] == mb.at( 0, mb.height - 1 ).mv[1])) )
+          if ( (pu.cu->affineType == AFFINEMODEL_4PARAM && (cpmv[0][0] == cpmv[1][0]) && (cpmv[0][1] == cpmv[1][1]))
+            || (pu.cu->affineType == AFFINEMODEL_6PARAM && (cpmv[0][0] == cpmv[1][0]) && (cpmv[0][1] == cpmv[1][1]) && (cpmv[0][2] == cpmv[1][2])) 
+			|| (pu.cu->affineType == AFFINEMODEL_8PARAM && (cpmv[0][0] == cpmv[1][0]) && (cpmv[0][1] == cpmv[1][1]) && (cpmv[0][2] == cpmv[1][2])) )
 #else
-          if ( (mb.at( 0, 0 ).mv[0] == mb.at( 0, 0 ).mv[1]) && (mb.at( mb.width - 1, 0 ).mv[0] == mb.at( mb.width - 1, 0 ).mv[1]) )
+          if ( (cpmv[0][0] == cpmv[1][0]) && (cpmv[0][1] == cpmv[1][1]) )
 #endif
 #else
-          if( ( mb.at( 0, 0 ).mv[0] == mb.at( 0, 0 ).mv[1] ) && ( mb.at( mb.width - 1, 0 ).mv[0] == mb.at( mb.width - 1, 0 ).mv[1] ) && ( mb.at( 0, mb.height - 1 ).mv[0] == mb.at( 0, mb.height - 1 ).mv[1] ) )
+          if( ( cpmv[0][0] == cpmv[1][0] ) && ( cpmv[0][1] == cpmv[1][1] ) && ( cpmv[0][2] == cpmv[1][2] ) )
 #endif
           {
             return true;
@@ -379,11 +395,10 @@ void InterPrediction::xPredInterUni(const PredictionUnit& pu, const RefPicList&
   {
     CHECK( iRefIdx < 0, "iRefIdx incorrect." );
 
-    const CMotionBuf &mb = pu.getMotionBuf();
-    mv[0] = mb.at( 0,            0             ).mv[eRefPicList];
-    mv[1] = mb.at( mb.width - 1, 0             ).mv[eRefPicList];
-    mv[2] = mb.at( 0,            mb.height - 1 ).mv[eRefPicList];
-	mv[3] = mb.at( mb.width - 1, mb.height - 1 ).mv[eRefPicList];
+    mv[0] = pu.mvAffi[eRefPicList][0];
+    mv[1] = pu.mvAffi[eRefPicList][1];
+    mv[2] = pu.mvAffi[eRefPicList][2];
+    mv[3] = pu.mvAffi[eRefPicList][3];
 
 #if !JVET_K_AFFINE_BUG_FIXES
     clipMv(mv[1], pu.cu->lumaPos(), sps);
@@ -481,6 +496,53 @@ void InterPrediction::xPredInterBi(PredictionUnit& pu, PelUnitBuf &pcYuvPred)
 }
 
 
+/** check if an area of a reference lies inside its picture extended by the padded margin */
+bool InterPrediction::xRefInsideMargin( const Picture* refPic, const ComponentID compID, const Area& area )
+{
+  const CompArea& pic     = refPic->blocks[compID];
+  const int       marginX = refPic->margin >> getComponentScaleX( compID, refPic->chromaFormat );
+  const int       marginY = refPic->margin >> getComponentScaleY( compID, refPic->chromaFormat );
+
+  return area.x >= -marginX && area.x + ( int ) area.width  <= ( int ) pic.width  + marginX
+      && area.y >= -marginY && area.y + ( int ) area.height <= ( int ) pic.height + marginY;
+}
+
+/** copy an area of a reference picture with the coordinates clamped to the picture, which reproduces the border extension */
+void InterPrediction::xFetchClampedRef( const CPelBuf& pic, const Area& area, Pel* dst, int dstStride )
+{
+  const int left  = std::min<int>( std::max<int>( 0, -area.x ), area.width );
+  const int right = std::min<int>( std::max<int>( 0, area.x + ( int ) area.width - ( int ) pic.width ), area.width - left );
+  const int mid   = area.width - left - right;
+
+  for( int y = 0; y < area.height; y++, dst += dstStride )
+  {
+    const Pel* src = pic.bufAt( 0, Clip3<int>( 0, pic.height - 1, area.y + y ) );
+
+    std::fill_n( dst, left, src[0] );
+    if( mid > 0 )
+    {
+      ::memcpy( dst + left, src + area.x + left, mid * sizeof( Pel ) );
+    }
+    std::fill_n( dst + left + std::max( mid, 0 ), right, src[pic.width - 1] );
+  }
+}
+
+/** get the reference samples of a block, read in place if the block and its filter support are covered by the padded
+ *  margin and fetched with clamped coordinates otherwise, e.g. for references stored without a margin */
+CPelBuf InterPrediction::xGetRefBuf( const Picture* refPic, const ComponentID compID, const Position& pos, const Size& size )
+{
+  const int  ext     = ( isLuma( compID ) ? NTAPS_LUMA : NTAPS_CHROMA ) >> 1;
+  const Area support( pos.x - ( ext - 1 ), pos.y - ( ext - 1 ), size.width + 2 * ext - 1, size.height + 2 * ext - 1 );
+
+  if( xRefInsideMargin( refPic, compID, support ) )
+  {
+    return refPic->getRecoBuf( CompArea( compID, refPic->chromaFormat, pos, size ) );
+  }
+
+  xFetchClampedRef( refPic->getRecoBuf( compID ), support, m_refFetchBuf, support.width );
+  return CPelBuf( m_refFetchBuf + ( ext - 1 ) * support.width + ( ext - 1 ), support.width, size );
+}
+
 void InterPrediction::xPredInterBlk ( const ComponentID& compID, const PredictionUnit& pu, const Picture* refPic, const Mv& _mv, PelUnitBuf& dstPic, const bool& bi, const ClpRng& clpRng
                                     )
 {
@@ -526,8 +588,8 @@ void InterPrediction::xPredInterBlk ( const ComponentID& compID, const Predictio
 
   CPelBuf refBuf;
   {
-    Position offset = pu.blocks[compID].pos().offset( _mv.getHor() >> shiftHor, _mv.getVer() >> shiftVer );
-    refBuf = refPic->getRecoBuf( CompArea( compID, chFmt, offset, pu.blocks[compID].size() ) );
+    const Position offset = pu.blocks[compID].pos().offset( _mv.getHor() >> shiftHor, _mv.getVer() >> shiftVer );
+    refBuf = xGetRefBuf( refPic, compID, offset, pu.blocks[compID].size() );
   }
 
 
@@ -550,9 +612,59 @@ void InterPrediction::xPredInterBlk ( const ComponentID& compID, const Predictio
     JVET_J0090_SET_CACHE_ENABLE( true );
   }
 
+  if( m_fetchStats )
+  {
+    const int vFilterSize = isLuma( compID ) ? NTAPS_LUMA : NTAPS_CHROMA;
+    m_fetchStats->addFetch( MC_FETCH_TRANSLATIONAL, width * height, ( width + ( xFrac ? vFilterSize - 1 : 0 ) ) * ( height + ( yFrac ? vFilterSize - 1 : 0 ) ) );
+  }
 }
 
 #if JVET_K_AFFINE
+/** derive the luma sub-block size of the affine MC from the spread of the control point MVs (high precision)
+ *
+ * The largest size out of 16x16, 8x8 and 4x4 is chosen for which the MV does not change by more than a quarter
+ * sample across one sub-block edge. The derivation only uses the CPMVs, so encoder and decoder select the same size.
+ */
+int InterPrediction::xGetAffineSubblockSize( const PredictionUnit& pu, const Mv& mvLT, const Mv& mvRT, const Mv& mvLB, const Mv& mvRB )
+{
+  const int width  = pu.lwidth();
+  const int height = pu.lheight();
+
+  auto maxComp = []( const Mv& mv ) { return std::max( abs( mv.getHor() ), abs( mv.getVer() ) ); };
+
+  // MV change along a row (over the width) and along a column (over spanVer samples), the 4-parameter model has
+  // the same gradient in both directions, so its column change is the row change over the width
+  int spreadHor = maxComp( mvRT - mvLT );
+  int spreadVer = spreadHor;
+  int spanVer   = width;
+#if JVET_K0337_AFFINE_6PARA
+  if( pu.cu->affineType == AFFINEMODEL_6PARAM || pu.cu->affineType == AFFINEMODEL_8PARAM )
+  {
+    spreadVer = maxComp( mvLB - mvLT );
+    spanVer   = height;
+  }
+  if( pu.cu->affineType == AFFINEMODEL_8PARAM )
+  {
+    // the perspective field is not linear, use the larger change of the two opposite edges
+    spreadHor = std::max( spreadHor, maxComp( mvRB - mvLB ) );
+    spreadVer = std::max( spreadVer, maxComp( mvRB - mvRT ) );
+  }
+#endif
+
+  // a quarter sample in high precision MV units
+  const int maxStep = 1 << VCEG_AZ07_MV_ADD_PRECISION_BIT_FOR_STORE;
+
+  for( int size = AFFINE_MAX_BLOCK_SIZE; size > AFFINE_MIN_BLOCK_SIZE; size >>= 1 )
+  {
+    if( size <= width && size <= height && size * spreadHor <= maxStep * width && size * spreadVer <= maxStep * spanVer )
+    {
+      return size;
+    }
+  }
+
+  return AFFINE_MIN_BLOCK_SIZE;
+}
+
 void InterPrediction::xPredAffineBlk( const ComponentID& compID, const PredictionUnit& pu, const Picture* refPic, const Mv* _mv, PelUnitBuf& dstPic, const bool& bi, const ClpRng& clpRng )
 {
 #if JVET_K0337_AFFINE_6PARA
@@ -595,6 +707,10 @@ void InterPrediction::xPredAffineBlk( const ComponentID& compID, const Predictio
 #if JVET_K0184_AFFINE_4X4
   int blockWidth = AFFINE_MIN_BLOCK_SIZE;
   int blockHeight = AFFINE_MIN_BLOCK_SIZE;
+  if( pu.cs->sps->getSpsNext().getUseAffineAdaptiveSubblock() )
+  {
+    blockWidth = blockHeight = xGetAffineSubblockSize( pu, mvLT, mvRT, mvLB, mvRB );
+  }
 #else
   int blockWidth   = width;
   int blockHeight  = height;
@@ -717,7 +833,12 @@ void InterPrediction::xPredAffineBlk( const ComponentID& compID, const Predictio
 
   const int shift = iBit - 4 + VCEG_AZ07_MV_ADD_PRECISION_BIT_FOR_STORE + 2;
 
-  // get prediction block by block
+  // derive the sub-block MVs, the interpolation only starts when the reference footprint of the whole PU is known
+  AffineSubblockMv* sbMv = m_affineSubblockMv;
+  int numSb = 0;
+  int minX  = std::numeric_limits<int>::max(), maxX = std::numeric_limits<int>::min();
+  int minY  = std::numeric_limits<int>::max(), maxY = std::numeric_limits<int>::min();
+
   for ( int h = 0; h < cxHeight; h += blockHeight )
   {
     for ( int w = 0; w < cxWidth; w += blockWidth )
@@ -774,26 +895,120 @@ void InterPrediction::xPredAffineBlk( const ComponentID& compID, const Predictio
         yFrac = iMvScaleTmpVer & 31;
       }
 
-      const CPelBuf refBuf = refPic->getRecoBuf( CompArea( compID, chFmt, pu.blocks[compID].offset(xInt + w, yInt + h), pu.blocks[compID] ) );
-      PelBuf &dstBuf = dstPic.bufs[compID];
+      AffineSubblockMv& sb = sbMv[numSb++];
+      sb.refX  = xInt + w;
+      sb.refY  = yInt + h;
+      sb.xFrac = xFrac;
+      sb.yFrac = yFrac;
 
-      if ( yFrac == 0 )
-      {
-        m_if.filterHor( compID, (Pel*) refBuf.buf, refBuf.stride, dstBuf.buf + w + h * dstBuf.stride, dstBuf.stride, blockWidth, blockHeight, xFrac, !bi, chFmt, clpRng );
-      }
-      else if ( xFrac == 0 )
-      {
-        m_if.filterVer( compID, (Pel*) refBuf.buf, refBuf.stride, dstBuf.buf + w + h * dstBuf.stride, dstBuf.stride, blockWidth, blockHeight, yFrac, true, !bi, chFmt, clpRng );
-      }
-      else
+      minX = std::min( minX, sb.refX );
+      minY = std::min( minY, sb.refY );
+      maxX = std::max( maxX, sb.refX + blockWidth );
+      maxY = std::max( maxY, sb.refY + blockHeight );
+    }
+  }
+
+  // sub-block positions are relative to the PU, the reference is either the picture or the prefetched tile
+  const CPelBuf refPicBuf = refPic->getRecoBuf( pu.blocks[compID] );
+  const Pel*    refOrg    = refPicBuf.buf;
+  int           refStride = refPicBuf.stride;
+  int           refX0     = 0;
+  int           refY0     = 0;
+  PelBuf&       dstBuf    = dstPic.bufs[compID];
+
+  // footprint of all sub-blocks including the filter support, references without padding are fetched clamped
+  const Area footprint( pu.blocks[compID].x + minX - ( ( vFilterSize >> 1 ) - 1 ), pu.blocks[compID].y + minY - ( ( vFilterSize >> 1 ) - 1 ),
+                        maxX - minX + vFilterSize - 1, maxY - minY + vFilterSize - 1 );
+  const bool insideMargin = xRefInsideMargin( refPic, compID, footprint );
+
+#if ENABLE_AFFINE_MC_REF_TILE
+  const int tileX0 = minX - ( ( vFilterSize >> 1 ) - 1 );
+  const int tileY0 = minY - ( ( vFilterSize >> 1 ) - 1 );
+  const int tileW  = maxX + ( vFilterSize >> 1 ) - tileX0;
+  const int tileH  = maxY + ( vFilterSize >> 1 ) - tileY0;
+
+  if( tileW <= AFFINE_REF_TILE_SIZE && tileH <= AFFINE_REF_TILE_SIZE )
+  {
+    // fetch the bounding box of all sub-block references once
+    const Pel* src = refOrg + tileY0 * refStride + tileX0;
+    Pel*       dst = m_affineRefTile;
+
+    if( insideMargin )
+    {
+      for( int y = 0; y < tileH; y++, src += refStride, dst += AFFINE_REF_TILE_SIZE )
       {
-        m_if.filterHor( compID, (Pel*) refBuf.buf - ((vFilterSize>>1) -1)*refBuf.stride, refBuf.stride, tmpBuf.buf, tmpBuf.stride, blockWidth, blockHeight+vFilterSize-1, xFrac, false,      chFmt, clpRng);
-        JVET_J0090_SET_CACHE_ENABLE( false );
-        m_if.filterVer( compID, tmpBuf.buf + ((vFilterSize>>1) -1)*tmpBuf.stride, tmpBuf.stride, dstBuf.buf + w + h * dstBuf.stride, dstBuf.stride, blockWidth, blockHeight, yFrac, false, !bi, chFmt, clpRng);
-        JVET_J0090_SET_CACHE_ENABLE( true );
+#if JVET_J0090_MEMORY_BANDWITH_MEASURE
+        for( int x = 0; x < tileW; x++ )
+        {
+          JVET_J0090_CACHE_ACCESS( &src[x], __FILE__, __LINE__ );
+        }
+#endif
+        ::memcpy( dst, src, tileW * sizeof( Pel ) );
       }
     }
+    else
+    {
+      xFetchClampedRef( refPic->getRecoBuf( compID ), footprint, dst, AFFINE_REF_TILE_SIZE );
+    }
+
+    refOrg    = m_affineRefTile;
+    refStride = AFFINE_REF_TILE_SIZE;
+    refX0     = tileX0;
+    refY0     = tileY0;
   }
+#endif
+  const bool useTile = refOrg != refPicBuf.buf;
+#if !JVET_J0090_MEMORY_BANDWITH_MEASURE
+  if( m_fetchStats )
+#endif
+  {
+    int sbFetch = 0;
+    for( int i = 0; i < numSb; i++ )
+    {
+      sbFetch += ( blockWidth + ( sbMv[i].xFrac ? vFilterSize - 1 : 0 ) ) * ( blockHeight + ( sbMv[i].yFrac ? vFilterSize - 1 : 0 ) );
+    }
+    const int fetched = useTile ? ( maxX - minX + vFilterSize - 1 ) * ( maxY - minY + vFilterSize - 1 ) : sbFetch;
+    JVET_J0090_AFFINE_FETCH( fetched, sbFetch );
+
+    if( m_fetchStats )
+    {
+      const MCFetchModel model = pu.cu->affineType == AFFINEMODEL_8PARAM ? MC_FETCH_PERSPECTIVE_8PARAM : pu.cu->affineType == AFFINEMODEL_6PARAM ? MC_FETCH_AFFINE_6PARAM : MC_FETCH_AFFINE_4PARAM;
+      m_fetchStats->addFetch( model, cxWidth * cxHeight, fetched );
+    }
+  }
+
+  // the accesses to the local tile are not counted as reference picture accesses
+  JVET_J0090_SET_CACHE_ENABLE( !useTile );
+
+  for( int i = 0; i < numSb; i++ )
+  {
+    const AffineSubblockMv& sb = sbMv[i];
+    const int  w      = ( i % ( cxWidth / blockWidth ) ) * blockWidth;
+    const int  h      = ( i / ( cxWidth / blockWidth ) ) * blockHeight;
+    const int  xFrac  = sb.xFrac;
+    const int  yFrac  = sb.yFrac;
+    const CPelBuf refBuf  = useTile || insideMargin
+                          ? CPelBuf( refOrg + ( sb.refY - refY0 ) * refStride + ( sb.refX - refX0 ), refStride, blockWidth, blockHeight )
+                          : xGetRefBuf( refPic, compID, pu.blocks[compID].pos().offset( sb.refX, sb.refY ), Size( blockWidth, blockHeight ) );
+
+    if ( yFrac == 0 )
+    {
+      m_if.filterHor( compID, (Pel*) refBuf.buf, refBuf.stride, dstBuf.buf + w + h * dstBuf.stride, dstBuf.stride, blockWidth, blockHeight, xFrac, !bi, chFmt, clpRng );
+    }
+    else if ( xFrac == 0 )
+    {
+      m_if.filterVer( compID, (Pel*) refBuf.buf, refBuf.stride, dstBuf.buf + w + h * dstBuf.stride, dstBuf.stride, blockWidth, blockHeight, yFrac, true, !bi, chFmt, clpRng );
+    }
+    else
+    {
+      m_if.filterHor( compID, (Pel*) refBuf.buf - ((vFilterSize>>1) -1)*refBuf.stride, refBuf.stride, tmpBuf.buf, tmpBuf.stride, blockWidth, blockHeight+vFilterSize-1, xFrac, false,      chFmt, clpRng);
+      JVET_J0090_SET_CACHE_ENABLE( false );
+      m_if.filterVer( compID, tmpBuf.buf + ((vFilterSize>>1) -1)*tmpBuf.stride, tmpBuf.stride, dstBuf.buf + w + h * dstBuf.stride, dstBuf.stride, blockWidth, blockHeight, yFrac, false, !bi, chFmt, clpRng);
+      JVET_J0090_SET_CACHE_ENABLE( !useTile );
+    }
+  }
+
+  JVET_J0090_SET_CACHE_ENABLE( true );
 }
 #endif
 
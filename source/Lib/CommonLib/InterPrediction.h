@@ -49,6 +49,7 @@
 
 #include "RdCost.h"
 #include "ContextModelling.h"
+#include "MCFetchStats.h"
 
 // forward declaration
 class Mv;
@@ -73,6 +74,18 @@ protected:
   Pel*                 m_acYuvPred            [NUM_REF_PIC_LIST_01][MAX_NUM_COMPONENT];
   Pel*                 m_filteredBlock        [LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS][LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS][MAX_NUM_COMPONENT];
   Pel*                 m_filteredBlockTmp     [LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS][MAX_NUM_COMPONENT];
+#if JVET_K_AFFINE
+  struct AffineSubblockMv
+  {
+    int refX, refY;                          ///< integer reference position of the sub-block relative to the PU
+    int xFrac, yFrac;                        ///< fractional MV part
+  };
+  AffineSubblockMv     m_affineSubblockMv     [( MAX_CU_SIZE / AFFINE_MIN_BLOCK_SIZE ) * ( MAX_CU_SIZE / AFFINE_MIN_BLOCK_SIZE )];
+#if ENABLE_AFFINE_MC_REF_TILE
+  Pel*                 m_affineRefTile;        ///< local copy of the reference footprint of an affine PU
+#endif
+#endif
+  Pel*                 m_refFetchBuf;          ///< reference samples of a block fetched with clamped coordinates
 
 
   ChromaFormat         m_currChromaFormat;
@@ -82,16 +95,24 @@ protected:
   RdCost*              m_pcRdCost;
 
   int                  m_iRefListIdx;
+#if JVET_J0090_MEMORY_BANDWITH_MEASURE
+  CacheModel*          m_cacheModel;
+#endif
+  MCFetchStats*        m_fetchStats;           ///< reference fetch statistics, nullptr if disabled
   
 
   void xPredInterUni            ( const PredictionUnit& pu, const RefPicList& eRefPicList, PelUnitBuf& pcYuvPred, const bool& bi );
   void xPredInterBi             ( PredictionUnit& pu, PelUnitBuf &pcYuvPred );
   void xPredInterBlk            ( const ComponentID& compID, const PredictionUnit& pu, const Picture* refPic, const Mv& _mv, PelUnitBuf& dstPic, const bool& bi, const ClpRng& clpRng
                                  );
+  static bool xRefInsideMargin  ( const Picture* refPic, const ComponentID compID, const Area& area );
+  static void xFetchClampedRef  ( const CPelBuf& pic, const Area& area, Pel* dst, int dstStride );
+  CPelBuf     xGetRefBuf        ( const Picture* refPic, const ComponentID compID, const Position& pos, const Size& size );
   
   void xWeightedAverage         ( const PredictionUnit& pu, const CPelUnitBuf& pcYuvSrc0, const CPelUnitBuf& pcYuvSrc1, PelUnitBuf& pcYuvDst, const BitDepths& clipBitDepths, const ClpRngs& clpRngs );
 #if JVET_K_AFFINE
   void xPredAffineBlk( const ComponentID& compID, const PredictionUnit& pu, const Picture* refPic, const Mv* _mv, PelUnitBuf& dstPic, const bool& bi, const ClpRng& clpRng);
+  static int xGetAffineSubblockSize( const PredictionUnit& pu, const Mv& mvLT, const Mv& mvRT, const Mv& mvLB, const Mv& mvRB );
 #endif
 
   static bool xCheckIdenticalMotion( const PredictionUnit& pu );
@@ -121,6 +142,7 @@ public:
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   void    cacheAssign( CacheModel *cache );
 #endif
+  void    setFetchStats       ( MCFetchStats* fetchStats ) { m_fetchStats = fetchStats; }
 
 };
 
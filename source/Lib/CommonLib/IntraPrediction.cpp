@@ -102,6 +102,19 @@ IntraPrediction::IntraPrediction()
   }
 
   m_piTemp = nullptr;
+
+  m_predAngCore       = predIntraAngCore;
+  m_pdpcFilterDiag    = pdpcFilterDiag;
+  m_pdpcFilterNonAng  = pdpcFilterNonAng;
+  m_filterRefRow      = filterRefSamplesRow;
+  m_transposeBlk      = transposeBlk;
+  m_downsampleLumaRec = downsampleLumaRec;
+
+#if ENABLE_SIMD_OPT_INTRAPRED
+#ifdef TARGET_SIMD_X86
+  initIntraPredictionX86();
+#endif
+#endif
 }
 
 IntraPrediction::~IntraPrediction()
@@ -164,6 +177,154 @@ void IntraPrediction::init(ChromaFormat chromaFormatIDC, const unsigned bitDepth
   }
 }
 
+// ====================================================================================================================
+// Sample processing kernels (replaced by SIMD versions when available)
+// ====================================================================================================================
+
+void IntraPrediction::predIntraAngCore( Pel* pDst, const int dstStride, const Pel* refMain, const int width, const int height, const int intraPredAngle )
+{
+  for( int y = 0, deltaPos = intraPredAngle; y < height; y++, deltaPos += intraPredAngle, pDst += dstStride )
+  {
+    const int deltaInt   = deltaPos >> 5;
+    const int deltaFract = deltaPos & ( 32 - 1 );
+    const Pel *pRM       = refMain + deltaInt + 1;
+
+    if( deltaFract )
+    {
+      // Do linear filtering
+      int lastRefMainPel = *pRM++;
+      for( int x = 0; x < width; pRM++, x++ )
+      {
+        int thisRefMainPel = *pRM;
+        pDst[x + 0] = ( Pel ) ( ( ( 32 - deltaFract )*lastRefMainPel + deltaFract*thisRefMainPel + 16 ) >> 5 );
+        lastRefMainPel = thisRefMainPel;
+      }
+    }
+    else
+    {
+      // Just copy the integer samples
+      memcpy( pDst, pRM, width * sizeof( Pel ) );
+    }
+  }
+}
+
+void IntraPrediction::pdpcFilterDiag( Pel* pDst, const int dstStride, const Pel* refMain, const Pel* refSide, const int width, const int height, const int scale, const ClpRng& clpRng )
+{
+  for( int y = 0; y < height; y++, pDst += dstStride )
+  {
+    int wT = 16 >> std::min( 31, ( ( y << 1 ) >> scale ) );
+
+    for( int x = 0; x < width; x++ )
+    {
+      int wL = 16 >> std::min( 31, ( ( x << 1 ) >> scale ) );
+      if( wT + wL == 0 ) break;
+
+      int c = x + y + 1;
+      const Pel left = ( wL != 0 ) ? refSide[c + 1] : 0;
+      const Pel top  = ( wT != 0 ) ? refMain[c + 1] : 0;
+
+      pDst[x] = ClipPel( ( wL * left + wT * top + ( 64 - wL - wT ) * pDst[x] + 32 ) >> 6, clpRng );
+    }
+  }
+}
+
+void IntraPrediction::pdpcFilterNonAng( Pel* pDst, const int dstStride, const Pel* pSrc, const int srcStride, const int iWidth, const int iHeight, const int scale, const uint32_t dirMode, const ClpRng& clpRng )
+{
+  const CPelBuf srcBuf( pSrc, srcStride, srcStride );
+  PelBuf        dstBuf( pDst, dstStride, iWidth, iHeight );
+
+  if (dirMode == PLANAR_IDX)
+  {
+    for (int y = 0; y < iHeight; y++)
+    {
+      int wT = 32 >> std::min(31, ((y << 1) >> scale));
+      const Pel left = srcBuf.at(0, y + 1);
+      for (int x = 0; x < iWidth; x++)
+      {
+        const Pel top = srcBuf.at(x + 1, 0);
+        int wL = 32 >> std::min(31, ((x << 1) >> scale));
+        dstBuf.at(x, y) = ClipPel((wL * left + wT * top + (64 - wL - wT) * dstBuf.at(x, y) + 32) >> 6, clpRng);
+      }
+    }
+  }
+  else if (dirMode == DC_IDX)
+  {
+    const Pel topLeft = srcBuf.at(0, 0);
+    for (int y = 0; y < iHeight; y++)
+    {
+      int wT = 32 >> std::min(31, ((y << 1) >> scale));
+      const Pel left = srcBuf.at(0, y + 1);
+      for (int x = 0; x < iWidth; x++)
+      {
+        const Pel top = srcBuf.at(x + 1, 0);
+        int wL = 32 >> std::min(31, ((x << 1) >> scale));
+        int wTL = (wL >> 4) + (wT >> 4);
+        dstBuf.at(x, y) = ClipPel((wL * left + wT * top - wTL * topLeft + (64 - wL - wT + wTL) * dstBuf.at(x, y) + 32) >> 6, clpRng);
+      }
+    }
+  }
+  else if (dirMode == HOR_IDX)
+  {
+    const Pel topLeft = srcBuf.at(0, 0);
+    for (int y = 0; y < iHeight; y++)
+    {
+      int wT = 32 >> std::min(31, ((y << 1) >> scale));
+      for (int x = 0; x < iWidth; x++)
+      {
+        const Pel top = srcBuf.at(x + 1, 0);
+        int wTL = wT;
+        dstBuf.at(x, y) = ClipPel((wT * top - wTL * topLeft + (64 - wT + wTL) * dstBuf.at(x, y) + 32) >> 6, clpRng);
+      }
+    }
+  }
+  else if (dirMode == VER_IDX)
+  {
+    const Pel topLeft = srcBuf.at(0, 0);
+    for (int y = 0; y < iHeight; y++)
+    {
+      const Pel left = srcBuf.at(0, y + 1);
+      for (int x = 0; x < iWidth; x++)
+      {
+        int wL = 32 >> std::min(31, ((x << 1) >> scale));
+        int wTL = wL;
+        dstBuf.at(x, y) = ClipPel((wL * left - wTL * topLeft + (64 - wL + wTL) * dstBuf.at(x, y) + 32) >> 6, clpRng);
+      }
+    }
+  }
+}
+
+void IntraPrediction::filterRefSamplesRow( const Pel* pSrc, Pel* pDst, const int length )
+{
+  for( int i = 0; i < length; i++ )
+  {
+    pDst[i] = ( pSrc[i + 1] + 2 * pSrc[i] + pSrc[i - 1] + 2 ) >> 2;
+  }
+}
+
+void IntraPrediction::transposeBlk( const Pel* pSrc, const int srcStride, Pel* pDst, const int dstStride, const int width, const int height )
+{
+  for( int y = 0; y < height; y++, pSrc += srcStride )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      pDst[x * dstStride + y] = pSrc[x];
+    }
+  }
+}
+
+void IntraPrediction::downsampleLumaRec( const Pel* pRecSrc, const int recStride, Pel* pDst, const int dstStride, const int width, const int height )
+{
+  for( int j = 0; j < height; j++, pRecSrc += 2 * recStride, pDst += dstStride )
+  {
+    for( int i = 0; i < width; i++ )
+    {
+      pDst[i] = ( pRecSrc[2 * i            ] * 2 + pRecSrc[2 * i + 1            ] + pRecSrc[2 * i - 1            ]
+                + pRecSrc[2 * i + recStride] * 2 + pRecSrc[2 * i + 1 + recStride] + pRecSrc[2 * i - 1 + recStride]
+                + 4 ) >> 3;
+    }
+  }
+}
+
 // ====================================================================================================================
 // Public member functions
 // ====================================================================================================================
@@ -288,69 +449,10 @@ void IntraPrediction::predIntraAng( const ComponentID compId, PelBuf &piPred, co
   bool pdpcCondition = (uiDirMode == PLANAR_IDX || uiDirMode == DC_IDX || uiDirMode == HOR_IDX || uiDirMode == VER_IDX);
   if (pdpcCondition)
   {
-    const CPelBuf srcBuf = CPelBuf(ptrSrc, srcStride, srcStride);
-    PelBuf dstBuf = piPred;
     const int scale = ((g_aucLog2[iWidth] - 2 + g_aucLog2[iHeight] - 2 + 2) >> 2);
     CHECK(scale < 0 || scale > 31, "PDPC: scale < 0 || scale > 31");
 
-    if (uiDirMode == PLANAR_IDX)
-    {
-      for (int y = 0; y < iHeight; y++)
-      {
-        int wT = 32 >> std::min(31, ((y << 1) >> scale));
-        const Pel left = srcBuf.at(0, y + 1);
-        for (int x = 0; x < iWidth; x++)
-        {
-          const Pel top = srcBuf.at(x + 1, 0);
-          int wL = 32 >> std::min(31, ((x << 1) >> scale));
-          dstBuf.at(x, y) = ClipPel((wL * left + wT * top + (64 - wL - wT) * dstBuf.at(x, y) + 32) >> 6, clpRng);
-        }
-      }
-    }
-    else if (uiDirMode == DC_IDX)
-    {
-      const Pel topLeft = srcBuf.at(0, 0);
-      for (int y = 0; y < iHeight; y++)
-      {
-        int wT = 32 >> std::min(31, ((y << 1) >> scale));
-        const Pel left = srcBuf.at(0, y + 1);
-        for (int x = 0; x < iWidth; x++)
-        {
-          const Pel top = srcBuf.at(x + 1, 0);
-          int wL = 32 >> std::min(31, ((x << 1) >> scale));
-          int wTL = (wL >> 4) + (wT >> 4);
-          dstBuf.at(x, y) = ClipPel((wL * left + wT * top - wTL * topLeft + (64 - wL - wT + wTL) * dstBuf.at(x, y) + 32) >> 6, clpRng);
-        }
-      }
-    }
-    else if (uiDirMode == HOR_IDX)
-    {
-      const Pel topLeft = srcBuf.at(0, 0);
-      for (int y = 0; y < iHeight; y++)
-      {
-        int wT = 32 >> std::min(31, ((y << 1) >> scale));
-        for (int x = 0; x < iWidth; x++)
-        {
-          const Pel top = srcBuf.at(x + 1, 0);
-          int wTL = wT;
-          dstBuf.at(x, y) = ClipPel((wT * top - wTL * topLeft + (64 - wT + wTL) * dstBuf.at(x, y) + 32) >> 6, clpRng);
-        }
-      }
-    }
-    else if (uiDirMode == VER_IDX)
-    {
-      const Pel topLeft = srcBuf.at(0, 0);
-      for (int y = 0; y < iHeight; y++)
-      {
-        const Pel left = srcBuf.at(0, y + 1);
-        for (int x = 0; x < iWidth; x++)
-        {
-          int wL = 32 >> std::min(31, ((x << 1) >> scale));
-          int wTL = wL;
-          dstBuf.at(x, y) = ClipPel((wL * left - wTL * topLeft + (64 - wL + wTL) * dstBuf.at(x, y) + 32) >> 6, clpRng);
-        }
-      }
-    }
+    m_pdpcFilterNonAng( piPred.buf, piPred.stride, ptrSrc, srcStride, iWidth, iHeight, scale, uiDirMode, clpRng );
   }
 #else
 #if HEVC_USE_HOR_VER_PREDFILTERING
@@ -658,69 +760,31 @@ void IntraPrediction::xPredIntraAng( const CPelBuf &pSrc, PelBuf &pDst, const Ch
   }
   else
   {
-    Pel *pDsty=pDstBuf;
-
-    for (int y=0, deltaPos=intraPredAngle; y<height; y++, deltaPos+=intraPredAngle, pDsty+=dstStride)
-    {
-      const int deltaInt   = deltaPos >> 5;
-      const int deltaFract = deltaPos & (32 - 1);
+    // the interpolation reproduces the integer samples for a zero fractional position
+    m_predAngCore( pDstBuf, dstStride, refMain, width, height, intraPredAngle );
 
-#if HM_4TAPIF_AS_IN_JEM
-      if( deltaFract )
-#else
-      if( absAng < 32 )
-#endif
-      {
-        {
-          // Do linear filtering
-          const Pel *pRM = refMain + deltaInt + 1;
-          int lastRefMainPel = *pRM++;
-          for( int x = 0; x < width; pRM++, x++ )
-          {
-            int thisRefMainPel = *pRM;
-            pDsty[x + 0] = ( Pel ) ( ( ( 32 - deltaFract )*lastRefMainPel + deltaFract*thisRefMainPel + 16 ) >> 5 );
-            lastRefMainPel = thisRefMainPel;
-          }
-        }
-      }
-      else
-      {
-        // Just copy the integer samples
-        for( int x = 0; x < width; x++ )
-        {
-          pDsty[x] = refMain[x + deltaInt + 1];
-        }
-      }
 #if JVET_K0063_PDPC_SIMP
-      const int numModes = 8;
-      const int scale = ((g_aucLog2[width] - 2 + g_aucLog2[height] - 2 + 2) >> 2);
-      CHECK(scale < 0 || scale > 31, "PDPC: scale < 0 || scale > 31");
+    const int numModes = 8;
+    const int scale = ((g_aucLog2[width] - 2 + g_aucLog2[height] - 2 + 2) >> 2);
+    CHECK(scale < 0 || scale > 31, "PDPC: scale < 0 || scale > 31");
 
 #if JVET_K0500_WAIP
-      if (predMode == 2 || predMode == VDIA_IDX)
+    if (predMode == 2 || predMode == VDIA_IDX)
 #else
-      if (dirMode == 2 || dirMode == VDIA_IDX)
+    if (dirMode == 2 || dirMode == VDIA_IDX)
 #endif
-      {
-        int wT = 16 >> std::min(31, ((y << 1) >> scale));
-
-        for (int x = 0; x < width; x++)
-        {
-          int wL = 16 >> std::min(31, ((x << 1) >> scale));
-          if (wT + wL == 0) break;
-
-          int c = x + y + 1;
-          const Pel left = (wL != 0) ? refSide[c + 1] : 0;
-          const Pel top  = (wT != 0) ? refMain[c + 1] : 0;
-
-          pDsty[x] = ClipPel((wL * left + wT * top + (64 - wL - wT) * pDsty[x] + 32) >> 6, clpRng);
-        }
-      }
+    {
+      m_pdpcFilterDiag( pDstBuf, dstStride, refMain, refSide, width, height, scale, clpRng );
+    }
 #if JVET_K0500_WAIP
-      else if ((predMode >= VDIA_IDX - numModes && predMode != VDIA_IDX) || (predMode != 2 && predMode <= (2 + numModes)))
+    else if ((predMode >= VDIA_IDX - numModes && predMode != VDIA_IDX) || (predMode != 2 && predMode <= (2 + numModes)))
 #else
-      else if ((dirMode >= VDIA_IDX - numModes && dirMode < VDIA_IDX) || (dirMode > 2 && dirMode <= (2 + numModes)))
+    else if ((dirMode >= VDIA_IDX - numModes && dirMode < VDIA_IDX) || (dirMode > 2 && dirMode <= (2 + numModes)))
 #endif
+    {
+      Pel *pDsty = pDstBuf;
+
+      for (int y = 0; y < height; y++, pDsty += dstStride)
       {
         int invAngleSum0 = 2;
         for (int x = 0; x < width; x++)
@@ -745,8 +809,8 @@ void IntraPrediction::xPredIntraAng( const CPelBuf &pSrc, PelBuf &pDst, const Ch
           pDsty[x] = ClipPel((wL * left + (64 - wL) * pDsty[x] + 32) >> 6, clpRng);
         }
       }
-#endif
     }
+#endif
 #if HEVC_USE_HOR_VER_PREDFILTERING
     if( edgeFilter && absAng <= 1 )
     {
@@ -761,14 +825,7 @@ void IntraPrediction::xPredIntraAng( const CPelBuf &pSrc, PelBuf &pDst, const Ch
   // Flip the block if this is the horizontal mode
   if( !bIsModeVer )
   {
-    for( int y = 0; y < height; y++ )
-    {
-      for( int x = 0; x < width; x++ )
-      {
-        pDst.at( y, x ) = pDstBuf[x];
-      }
-      pDstBuf += dstStride;
-    }
+    m_transposeBlk( pDstBuf, dstStride, pDst.buf, pDst.stride, width, height );
   }
 }
 
@@ -1096,10 +1153,9 @@ void IntraPrediction::xFilterReferenceSamples( const Pel* refBufUnfiltered, Pel*
   piDestPtr++;
   piSrcPtr++;
   //top row (left-to-right)
-  for( uint32_t i=1; i < predSize; i++, piDestPtr++, piSrcPtr++ )
-  {
-    *piDestPtr = (piSrcPtr[1] + 2 * piSrcPtr[0] + piSrcPtr[-1] + 2) >> 2;
-  }
+  m_filterRefRow( piSrcPtr, piDestPtr, predSize - 1 );
+  piDestPtr += predSize - 1;
+  piSrcPtr  += predSize - 1;
   // top right (not filtered)
   *piDestPtr=*piSrcPtr;
 }
@@ -1380,18 +1436,14 @@ void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chrom
     pDst  = pDst0    - iDstStride;
     piSrc = pRecSrc0 - iRecStride2;
 
-    for( int i = 0; i < uiCWidth; i++ )
+    if( bLeftAvaillable )
     {
-      if( i == 0 && !bLeftAvaillable )
-      {
-        pDst[i] = ( piSrc[2 * i] + piSrc[2 * i + iRecStride] + 1 ) >> 1;
-      }
-      else
-      {
-        pDst[i] = ( ( ( piSrc[2 * i             ] * 2 ) + piSrc[2 * i - 1             ] + piSrc[2 * i + 1             ] )
-                  + ( ( piSrc[2 * i + iRecStride] * 2 ) + piSrc[2 * i - 1 + iRecStride] + piSrc[2 * i + 1 + iRecStride] )
-                  + 4 ) >> 3;
-      }
+      m_downsampleLumaRec( piSrc, iRecStride, pDst, iDstStride, uiCWidth, 1 );
+    }
+    else
+    {
+      pDst[0] = ( piSrc[0] + piSrc[iRecStride] + 1 ) >> 1;
+      m_downsampleLumaRec( piSrc + 2, iRecStride, pDst + 1, iDstStride, uiCWidth - 1, 1 );
     }
 #if !JVET_K0190
     if (pu.cs->sps->getSpsNext().isELMModeMMLM())
@@ -1539,24 +1591,17 @@ void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chrom
 
 
   // inner part from reconstructed picture buffer
-  for( int j = 0; j < uiCHeight; j++ )
+  if( bLeftAvaillable )
   {
-    for( int i = 0; i < uiCWidth; i++ )
+    m_downsampleLumaRec( pRecSrc0, iRecStride, pDst0, iDstStride, uiCWidth, uiCHeight );
+  }
+  else
+  {
+    for( int j = 0; j < uiCHeight; j++ )
     {
-      if( i == 0 && !bLeftAvaillable )
-      {
-        pDst0[i] = ( pRecSrc0[2 * i] + pRecSrc0[2 * i + iRecStride] + 1 ) >> 1;
-      }
-      else
-      {
-        pDst0[i] = ( pRecSrc0[2 * i             ] * 2 + pRecSrc0[2 * i + 1             ] + pRecSrc0[2 * i - 1             ]
-                   + pRecSrc0[2 * i + iRecStride] * 2 + pRecSrc0[2 * i + 1 + iRecStride] + pRecSrc0[2 * i - 1 + iRecStride]
-                   + 4 ) >> 3;
-      }
+      pDst0[j * iDstStride] = ( pRecSrc0[j * iRecStride2] + pRecSrc0[j * iRecStride2 + iRecStride] + 1 ) >> 1;
     }
-
-    pDst0    += iDstStride;
-    pRecSrc0 += iRecStride2;
+    m_downsampleLumaRec( pRecSrc0 + 2, iRecStride, pDst0 + 1, iDstStride, uiCWidth - 1, uiCHeight );
   }
 #if !JVET_K0190
   if (pu.cs->sps->getSpsNext().isELMModeMFLM())
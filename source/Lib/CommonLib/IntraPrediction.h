@@ -136,6 +136,32 @@ public:
 
 static bool useFilteredIntraRefSamples( const ComponentID &compID, const PredictionUnit &pu, bool modeSpecific, const UnitArea &tuArea );
   static bool useDPCMForFirstPassIntraEstimation(const PredictionUnit &pu, const uint32_t &uiDirMode);
+
+  /// angular interpolation of a block in the vertical orientation (rows advance along refMain)
+  static void predIntraAngCore    ( Pel* pDst, const int dstStride, const Pel* refMain, const int width, const int height, const int intraPredAngle );
+  /// position dependent combination for the diagonal modes
+  static void pdpcFilterDiag      ( Pel* pDst, const int dstStride, const Pel* refMain, const Pel* refSide, const int width, const int height, const int scale, const ClpRng& clpRng );
+  /// position dependent combination for the planar, DC, horizontal and vertical modes
+  static void pdpcFilterNonAng    ( Pel* pDst, const int dstStride, const Pel* pSrc, const int srcStride, const int width, const int height, const int scale, const uint32_t dirMode, const ClpRng& clpRng );
+  /// [1 2 1] smoothing of a row of reference samples, reads pSrc[-1] and pSrc[length]
+  static void filterRefSamplesRow ( const Pel* pSrc, Pel* pDst, const int length );
+  /// pDst( y, x ) = pSrc( x, y ) for a width x height source block
+  static void transposeBlk        ( const Pel* pSrc, const int srcStride, Pel* pDst, const int dstStride, const int width, const int height );
+  /// 6-tap 4:2:0 down-sampling of the luma reconstruction for the cross-component prediction
+  static void downsampleLumaRec   ( const Pel* pRecSrc, const int recStride, Pel* pDst, const int dstStride, const int width, const int height );
+
+  void( *m_predAngCore       )    ( Pel* pDst, const int dstStride, const Pel* refMain, const int width, const int height, const int intraPredAngle );
+  void( *m_pdpcFilterDiag    )    ( Pel* pDst, const int dstStride, const Pel* refMain, const Pel* refSide, const int width, const int height, const int scale, const ClpRng& clpRng );
+  void( *m_pdpcFilterNonAng  )    ( Pel* pDst, const int dstStride, const Pel* pSrc, const int srcStride, const int width, const int height, const int scale, const uint32_t dirMode, const ClpRng& clpRng );
+  void( *m_filterRefRow      )    ( const Pel* pSrc, Pel* pDst, const int length );
+  void( *m_transposeBlk      )    ( const Pel* pSrc, const int srcStride, Pel* pDst, const int dstStride, const int width, const int height );
+  void( *m_downsampleLumaRec )    ( const Pel* pRecSrc, const int recStride, Pel* pDst, const int dstStride, const int width, const int height );
+
+#ifdef TARGET_SIMD_X86
+  void initIntraPredictionX86();
+  template <X86_VEXT vext>
+  void _initIntraPredictionX86();
+#endif
 };
 
 //! \}
@@ -43,6 +43,7 @@
 #include "UnitPartitioner.h"
 #include "dtrace_codingstruct.h"
 #include "dtrace_buffer.h"
+#include "ToolTimer.h"
 
 //! \ingroup CommonLib
 //! \{
@@ -111,7 +112,16 @@ static bool isAvailable( const CodingUnit& cu, const CodingUnit& cu2, const bool
 // ====================================================================================================================
 
 LoopFilter::LoopFilter()
+  : m_dPicProcessingTime( 0 )
 {
+  m_filterLumaSegs   = filterLumaSegs;
+  m_filterChromaSegs = filterChromaSegs;
+
+#if ENABLE_SIMD_OPT_DBLF
+#ifdef TARGET_SIMD_X86
+  initLoopFilterX86();
+#endif
+#endif
 }
 
 LoopFilter::~LoopFilter()
@@ -149,7 +159,10 @@ void LoopFilter::destroy()
 void LoopFilter::loopFilterPic( CodingStructure& cs
                                 )
 {
+  TOOL_TIMER( TOOL_DEBLOCKING );
+
   const PreCalcValues& pcv = *cs.pcv;
+  const clock_t  iBeforeTime = clock();
 
   DTRACE_UPDATE( g_trace_ctx, ( std::make_pair( "poc", cs.slice->getPOC() ) ) );
 #if ENABLE_TRACING
@@ -173,7 +186,11 @@ void LoopFilter::loopFilterPic( CodingStructure& cs
 
       const UnitArea ctuArea( pcv.chrFormat, Area( x << pcv.maxCUWidthLog2, y << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUWidth ) );
 
-      // CU-based deblocking
+      // boundary strengths of the whole CTU first, then CU-based deblocking
+      for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
+      {
+        xSetBoundaryStrengthCU( currCU, EDGE_VER );
+      }
       for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
       {
         xDeblockCU( currCU, EDGE_VER );
@@ -184,6 +201,10 @@ void LoopFilter::loopFilterPic( CodingStructure& cs
         memset( m_aapucBS       [EDGE_VER].data(), 0,     m_aapucBS       [EDGE_VER].byte_size() );
         memset( m_aapbEdgeFilter[EDGE_VER].data(), false, m_aapbEdgeFilter[EDGE_VER].byte_size() );
 
+        for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
+        {
+          xSetBoundaryStrengthCU( currCU, EDGE_VER );
+        }
         for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
         {
           xDeblockCU( currCU, EDGE_VER );
@@ -202,7 +223,11 @@ void LoopFilter::loopFilterPic( CodingStructure& cs
 
       const UnitArea ctuArea( pcv.chrFormat, Area( x << pcv.maxCUWidthLog2, y << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUWidth ) );
 
-      // CU-based deblocking
+      // boundary strengths of the whole CTU first, then CU-based deblocking
+      for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
+      {
+        xSetBoundaryStrengthCU( currCU, EDGE_HOR );
+      }
       for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
       {
         xDeblockCU( currCU, EDGE_HOR );
@@ -213,6 +238,10 @@ void LoopFilter::loopFilterPic( CodingStructure& cs
         memset( m_aapucBS       [EDGE_HOR].data(), 0,     m_aapucBS       [EDGE_HOR].byte_size() );
         memset( m_aapbEdgeFilter[EDGE_HOR].data(), false, m_aapbEdgeFilter[EDGE_HOR].byte_size() );
 
+        for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
+        {
+          xSetBoundaryStrengthCU( currCU, EDGE_HOR );
+        }
         for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
         {
           xDeblockCU( currCU, EDGE_HOR );
@@ -227,6 +256,8 @@ void LoopFilter::loopFilterPic( CodingStructure& cs
 
   DTRACE    ( g_trace_ctx, D_CRC, "LoopFilter" );
   DTRACE_CRC( g_trace_ctx, D_CRC, cs, cs.getRecoBuf() );
+
+  m_dPicProcessingTime = (double)( clock() - iBeforeTime ) / CLOCKS_PER_SEC;
 }
 
 
@@ -235,12 +266,12 @@ void LoopFilter::loopFilterPic( CodingStructure& cs
 // ====================================================================================================================
 
 /**
- Deblocking filter process in CU-based (the same function as conventional's)
+ Boundary strength derivation in CU-based, run for all CUs of a CTU before any of its edges is filtered
 
- \param cu               the CU to be deblocked
- \param edgeDir          the direction of the edge in block boundary (horizontal/vertical), which is added newly
+ \param cu               the CU to derive the boundary strengths for
+ \param edgeDir          the direction of the edge in block boundary (horizontal/vertical)
 */
-void LoopFilter::xDeblockCU( CodingUnit& cu, const DeblockEdgeDir edgeDir )
+void LoopFilter::xSetBoundaryStrengthCU( CodingUnit& cu, const DeblockEdgeDir edgeDir )
 {
   const PreCalcValues& pcv = *cu.cs->pcv;
   const Area area          = cu.Y().valid() ? cu.Y() : Area( recalcPosition( cu.chromaFormat, cu.chType, CHANNEL_TYPE_LUMA, cu.blocks[cu.chType].pos() ), recalcSize( cu.chromaFormat, cu.chType, CHANNEL_TYPE_LUMA, cu.blocks[cu.chType].size() ) );
@@ -302,6 +333,18 @@ void LoopFilter::xDeblockCU( CodingUnit& cu, const DeblockEdgeDir edgeDir )
       }
     }
   }
+}
+
+/**
+ Deblocking filter process in CU-based (the same function as conventional's)
+
+ \param cu               the CU to be deblocked
+ \param edgeDir          the direction of the edge in block boundary (horizontal/vertical), which is added newly
+*/
+void LoopFilter::xDeblockCU( CodingUnit& cu, const DeblockEdgeDir edgeDir )
+{
+  const PreCalcValues& pcv = *cu.cs->pcv;
+  const unsigned uiPelsInPart = pcv.minCUWidth;
 
 #if DB_TU_FIX==0
   const unsigned PartIdxIncr  = ( cu.cs->pcv->noRQT && cu.cs->pcv->only2Nx2N ? 1 : ( DEBLOCK_SMALLEST_BLOCK / uiPelsInPart ? DEBLOCK_SMALLEST_BLOCK / uiPelsInPart : 1 ) );
@@ -563,6 +606,10 @@ void LoopFilter::xEdgeFilterLuma(const CodingUnit& cu, const DeblockEdgeDir edge
   unsigned     uiBsAbsIdx   = 0, uiBs = 0;
   int          iOffset, iSrcStep;
 
+  LFSegParam   segs[MAX_CU_SIZE / ( DEBLOCK_SMALLEST_BLOCK / 2 )];
+  int          numSegs      = 0;
+  bool         bAnyFilter   = false;
+
   bool  bPCMFilter      = (sps.getUsePCM() && sps.getPCMFilterDisableFlag()) ? true : false;
   bool  bPartPNoFilter  = false;
   bool  bPartQNoFilter  = false;
@@ -631,54 +678,45 @@ void LoopFilter::xEdgeFilterLuma(const CodingUnit& cu, const DeblockEdgeDir edge
 
       const int iTc       = sm_tcTable  [iIndexTC] * iBitdepthScale;
       const int iBeta     = sm_betaTable[iIndexB ] * iBitdepthScale;
-      const int iSideThreshold = ( iBeta + ( iBeta >> 1 ) ) >> 3;
-      const int iThrCut   = iTc * 10;
+
+      bPartPNoFilter = bPartQNoFilter = false;
+      if( bPCMFilter )
+      {
+        // Check if each of PUs is I_PCM with LF disabling
+        bPartPNoFilter = cuP.ipcm;
+        bPartQNoFilter = cuQ.ipcm;
+      }
+      if( ppsTransquantBypassEnabledFlag )
+      {
+        // check if each of PUs is lossless coded
+        bPartPNoFilter = bPartPNoFilter || cuP.transQuantBypass;
+        bPartQNoFilter = bPartQNoFilter || cuQ.transQuantBypass;
+      }
 
       const unsigned uiBlocksInPart = pelsInPart / 4 ? pelsInPart / 4 : 1;
 
       for( int iBlkIdx = 0; iBlkIdx < uiBlocksInPart; iBlkIdx++ )
       {
-        const int dp0 = xCalcDP(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 0), iOffset);
-        const int dq0 = xCalcDQ(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 0), iOffset);
-        const int dp3 = xCalcDP(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 3), iOffset);
-        const int dq3 = xCalcDQ(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 3), iOffset);
-        const int d0 = dp0 + dq0;
-        const int d3 = dp3 + dq3;
-
-        const int dp = dp0 + dp3;
-        const int dq = dq0 + dq3;
-        const int d  = d0  + d3;
-
-        bPartPNoFilter = bPartQNoFilter = false;
-        if( bPCMFilter )
-        {
-          // Check if each of PUs is I_PCM with LF disabling
-          bPartPNoFilter = cuP.ipcm;
-          bPartQNoFilter = cuQ.ipcm;
-        }
-        if( ppsTransquantBypassEnabledFlag )
-        {
-          // check if each of PUs is lossless coded
-          bPartPNoFilter = bPartPNoFilter || cuP.transQuantBypass;
-          bPartQNoFilter = bPartQNoFilter || cuQ.transQuantBypass;
-        }
-
-        if( d < iBeta )
-        {
-          const bool bFilterP = (dp < iSideThreshold);
-          const bool bFilterQ = (dq < iSideThreshold);
-
-          const bool sw = xUseStrongFiltering( piTmpSrc + iSrcStep * ( iIdx*pelsInPart + iBlkIdx * 4 + 0 ), iOffset, 2 * d0, iBeta, iTc )
-                       && xUseStrongFiltering( piTmpSrc + iSrcStep * ( iIdx*pelsInPart + iBlkIdx * 4 + 3 ), iOffset, 2 * d3, iBeta, iTc );
+        segs[numSegs++] = LFSegParam{ iTc, iBeta, bPartPNoFilter, bPartQNoFilter };
+      }
+      bAnyFilter |= iTc > 0;
+    }
+    else
+    {
+      const unsigned uiBlocksInPart = pelsInPart / 4 ? pelsInPart / 4 : 1;
 
-          for( int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++ )
-          {
-            xPelFilterLuma( piTmpSrc + iSrcStep*( iIdx*pelsInPart + iBlkIdx * 4 + i ), iOffset, iTc, sw, bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterP, bFilterQ, clpRng );
-          }
-        }
+      for( int iBlkIdx = 0; iBlkIdx < uiBlocksInPart; iBlkIdx++ )
+      {
+        segs[numSegs++] = LFSegParam{ 0, 0, false, false };
       }
     }
   }
+
+  // a segment with tc equal to 0 is left unmodified by the filter, so the whole edge is processed in one batch
+  if( bAnyFilter )
+  {
+    m_filterLumaSegs( piTmpSrc, iOffset, iSrcStep, numSegs, segs, clpRng );
+  }
 }
 
 
@@ -759,6 +797,9 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
 
   const int iBitdepthScale = 1 << (sps.getBitDepth(CHANNEL_TYPE_CHROMA) - 8);
 
+  LFSegParam segs[2][MAX_CU_SIZE / ( DEBLOCK_SMALLEST_BLOCK / 2 )];
+  bool       bAnyFilter = false;
+
   for( int iIdx = 0; iIdx < uiNumParts; iIdx++ )
   {
     pos.x += xoffset;
@@ -767,6 +808,8 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
     uiBsAbsIdx = getRasterIdx( pos, pcv );
     ucBs       = m_aapucBS[edgeDir][uiBsAbsIdx];
 
+    segs[0][iIdx] = segs[1][iIdx] = LFSegParam{ 0, 0, false, false };
+
     if (ucBs > 1)
     {
       const CodingUnit& cuQ =  cu;
@@ -805,9 +848,7 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
 
       for( int chromaIdx = 0; chromaIdx < 2; chromaIdx++ )
       {
-        const ClpRng& clpRng( cu.cs->slice->clpRng( ComponentID( chromaIdx + 1 )) );
         const int chromaQPOffset = pps.getQpOffset( ComponentID( chromaIdx + 1 ) );
-        Pel* piTmpSrcChroma = (chromaIdx == 0) ? piTmpSrcCb : piTmpSrcCr;
 
         int iQP = ( ( cuP.qp + cuQ.qp + 1 ) >> 1 ) + chromaQPOffset;
         if (iQP >= chromaQPMappingTableSize)
@@ -829,17 +870,107 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
         const int iIndexTC = Clip3<int>( 0, MAX_QP + DEFAULT_INTRA_TC_OFFSET, iQP + DEFAULT_INTRA_TC_OFFSET*( ucBs - 1 ) + ( tcOffsetDiv2 << 1 ) );
         const int iTc      = sm_tcTable[iIndexTC] * iBitdepthScale;
 
-        for( unsigned uiStep = 0; uiStep < uiLoopLength; uiStep++ )
-        {
-          xPelFilterChroma( piTmpSrcChroma + iSrcStep*( uiStep + iIdx*uiLoopLength ), iOffset, iTc, bPartPNoFilter, bPartQNoFilter, clpRng );
-        }
+        segs[chromaIdx][iIdx] = LFSegParam{ iTc, 0, bPartPNoFilter, bPartQNoFilter };
+        bAnyFilter |= iTc > 0;
       }
     }
   }
+
+  if( bAnyFilter )
+  {
+    for( int chromaIdx = 0; chromaIdx < 2; chromaIdx++ )
+    {
+      const ClpRng& clpRng( cu.cs->slice->clpRng( ComponentID( chromaIdx + 1 )) );
+      Pel* piTmpSrcChroma = (chromaIdx == 0) ? piTmpSrcCb : piTmpSrcCr;
+
+      m_filterChromaSegs( piTmpSrcChroma, iOffset, iSrcStep, uiNumParts, uiLoopLength, segs[chromaIdx], clpRng );
+    }
+  }
 }
 
 
 
+/**
+ - Deblocking of consecutive 4-line segments along one luma edge
+ .
+ \param piSrc           pointer to the first sample of the edge on side Q
+ \param iOffset         offset value for picture data across the edge
+ \param iSrcStep        offset value for picture data along the edge
+ \param numSegs         number of segments
+ \param segs            filter parameters of each segment
+ \param clpRng          clipping range
+*/
+void LoopFilter::filterLumaSegs( Pel* piSrc, const int iOffset, const int iSrcStep, const int numSegs, const LFSegParam* segs, const ClpRng& clpRng )
+{
+  for( int iSeg = 0; iSeg < numSegs; iSeg++ )
+  {
+    const LFSegParam& seg = segs[iSeg];
+
+    if( seg.tc == 0 )
+    {
+      continue;
+    }
+
+    Pel* piTmpSrc = piSrc + iSrcStep * iSeg * ( DEBLOCK_SMALLEST_BLOCK / 2 );
+
+    const int dp0 = xCalcDP( piTmpSrc + iSrcStep * 0, iOffset );
+    const int dq0 = xCalcDQ( piTmpSrc + iSrcStep * 0, iOffset );
+    const int dp3 = xCalcDP( piTmpSrc + iSrcStep * 3, iOffset );
+    const int dq3 = xCalcDQ( piTmpSrc + iSrcStep * 3, iOffset );
+    const int d0  = dp0 + dq0;
+    const int d3  = dp3 + dq3;
+
+    const int dp  = dp0 + dp3;
+    const int dq  = dq0 + dq3;
+    const int d   = d0  + d3;
+
+    if( d < seg.beta )
+    {
+      const int  iSideThreshold = ( seg.beta + ( seg.beta >> 1 ) ) >> 3;
+      const int  iThrCut        = seg.tc * 10;
+      const bool bFilterP       = ( dp < iSideThreshold );
+      const bool bFilterQ       = ( dq < iSideThreshold );
+
+      const bool sw = xUseStrongFiltering( piTmpSrc + iSrcStep * 0, iOffset, 2 * d0, seg.beta, seg.tc )
+                   && xUseStrongFiltering( piTmpSrc + iSrcStep * 3, iOffset, 2 * d3, seg.beta, seg.tc );
+
+      for( int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++ )
+      {
+        xPelFilterLuma( piTmpSrc + iSrcStep * i, iOffset, seg.tc, sw, seg.partPNoFilter, seg.partQNoFilter, iThrCut, bFilterP, bFilterQ, clpRng );
+      }
+    }
+  }
+}
+
+/**
+ - Deblocking of consecutive segments along one chroma edge
+ .
+ \param piSrc           pointer to the first sample of the edge on side Q
+ \param iOffset         offset value for picture data across the edge
+ \param iSrcStep        offset value for picture data along the edge
+ \param numSegs         number of segments
+ \param segLength       number of lines of each segment
+ \param segs            filter parameters of each segment
+ \param clpRng          clipping range
+*/
+void LoopFilter::filterChromaSegs( Pel* piSrc, const int iOffset, const int iSrcStep, const int numSegs, const int segLength, const LFSegParam* segs, const ClpRng& clpRng )
+{
+  for( int iSeg = 0; iSeg < numSegs; iSeg++ )
+  {
+    const LFSegParam& seg = segs[iSeg];
+
+    if( seg.tc == 0 )
+    {
+      continue;
+    }
+
+    for( int uiStep = 0; uiStep < segLength; uiStep++ )
+    {
+      xPelFilterChroma( piSrc + iSrcStep * ( uiStep + iSeg * segLength ), iOffset, seg.tc, seg.partPNoFilter, seg.partQNoFilter, clpRng );
+    }
+  }
+}
+
 /**
  - Deblocking for the luminance component with strong or weak filter
  .
@@ -854,7 +985,7 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
  \param bFilterSecondQ  decision weak filter/no filter for partQ
  \param bitDepthLuma    luma bit depth
 */
-inline void LoopFilter::xPelFilterLuma( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng ) const
+inline void LoopFilter::xPelFilterLuma( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng )
 {
   int delta;
 
@@ -926,7 +1057,7 @@ inline void LoopFilter::xPelFilterLuma( Pel* piSrc, const int iOffset, const int
  \param bPartQNoFilter  indicator to disable filtering on partQ
  \param bitDepthChroma  chroma bit depth
  */
-inline void LoopFilter::xPelFilterChroma( Pel* piSrc, const int iOffset, const int tc, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng ) const
+inline void LoopFilter::xPelFilterChroma( Pel* piSrc, const int iOffset, const int tc, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng )
 {
   int delta;
 
@@ -958,7 +1089,7 @@ inline void LoopFilter::xPelFilterChroma( Pel* piSrc, const int iOffset, const i
  \param tc              tc value
  \param piSrc           pointer to picture data
  */
-inline bool LoopFilter::xUseStrongFiltering( Pel* piSrc, const int iOffset, const int d, const int beta, const int tc ) const
+inline bool LoopFilter::xUseStrongFiltering( Pel* piSrc, const int iOffset, const int d, const int beta, const int tc )
 {
   const Pel m4 = piSrc[ 0          ];
   const Pel m3 = piSrc[-iOffset    ];
@@ -970,12 +1101,12 @@ inline bool LoopFilter::xUseStrongFiltering( Pel* piSrc, const int iOffset, cons
   return ( ( d_strong < ( beta >> 3 ) ) && ( d < ( beta >> 2 ) ) && ( abs( m3 - m4 ) < ( ( tc * 5 + 1 ) >> 1 ) ) );
 }
 
-inline int LoopFilter::xCalcDP( Pel* piSrc, const int iOffset ) const
+inline int LoopFilter::xCalcDP( Pel* piSrc, const int iOffset )
 {
   return abs( piSrc[-iOffset * 3] - 2 * piSrc[-iOffset * 2] + piSrc[-iOffset] );
 }
 
-inline int LoopFilter::xCalcDQ( Pel* piSrc, const int iOffset ) const
+inline int LoopFilter::xCalcDQ( Pel* piSrc, const int iOffset )
 {
   return abs( piSrc[0] - 2 * piSrc[iOffset] + piSrc[iOffset * 2] );
 }
@@ -58,9 +58,12 @@ private:
   static_vector<char, MAX_NUM_PARTS_IN_CTU> m_aapucBS       [NUM_EDGE_DIR];         ///< Bs for [Ver/Hor][Y/U/V][Blk_Idx]
   static_vector<bool, MAX_NUM_PARTS_IN_CTU> m_aapbEdgeFilter[NUM_EDGE_DIR];
   LFCUParam m_stLFCUParam;                   ///< status structure
+  double    m_dPicProcessingTime;            ///< time spent in the last picture-level deblocking
 
 private:
-  /// CU-level deblocking function
+  /// CU-level boundary strength derivation
+  void xSetBoundaryStrengthCU     (       CodingUnit& cu, const DeblockEdgeDir edgeDir );
+  /// CU-level deblocking function, uses the boundary strengths of the whole CTU
   void xDeblockCU                 (       CodingUnit& cu, const DeblockEdgeDir edgeDir );
 
   // set / get functions
@@ -79,12 +82,29 @@ private:
   void xEdgeFilterLuma            ( const CodingUnit& cu, const DeblockEdgeDir edgeDir, const int iEdge );
   void xEdgeFilterChroma          ( const CodingUnit& cu, const DeblockEdgeDir edgeDir, const int iEdge );
 
-  inline void xPelFilterLuma      ( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng ) const;
-  inline void xPelFilterChroma    ( Pel* piSrc, const int iOffset, const int tc,                const bool bPartPNoFilter, const bool bPartQNoFilter,                                                                          const ClpRng& clpRng ) const;
+  static inline void xPelFilterLuma      ( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng );
+  static inline void xPelFilterChroma    ( Pel* piSrc, const int iOffset, const int tc,                const bool bPartPNoFilter, const bool bPartQNoFilter,                                                                          const ClpRng& clpRng );
 
-  inline bool xUseStrongFiltering ( Pel* piSrc, const int iOffset, const int d, const int beta, const int tc ) const;
-  inline int xCalcDP              ( Pel* piSrc, const int iOffset ) const;
-  inline int xCalcDQ              ( Pel* piSrc, const int iOffset ) const;
+  static inline bool xUseStrongFiltering ( Pel* piSrc, const int iOffset, const int d, const int beta, const int tc );
+  static inline int xCalcDP              ( Pel* piSrc, const int iOffset );
+  static inline int xCalcDQ              ( Pel* piSrc, const int iOffset );
+
+public:
+  /// filtering of numSegs consecutive luma segments of 4 lines along one edge
+  static void filterLumaSegs      ( Pel* piSrc, const int iOffset, const int iSrcStep, const int numSegs,                      const LFSegParam* segs, const ClpRng& clpRng );
+  /// filtering of numSegs consecutive chroma segments of segLength lines along one edge
+  static void filterChromaSegs    ( Pel* piSrc, const int iOffset, const int iSrcStep, const int numSegs, const int segLength, const LFSegParam* segs, const ClpRng& clpRng );
+
+  void( *m_filterLumaSegs   )     ( Pel* piSrc, const int iOffset, const int iSrcStep, const int numSegs,                      const LFSegParam* segs, const ClpRng& clpRng );
+  void( *m_filterChromaSegs )     ( Pel* piSrc, const int iOffset, const int iSrcStep, const int numSegs, const int segLength, const LFSegParam* segs, const ClpRng& clpRng );
+
+#ifdef TARGET_SIMD_X86
+  void initLoopFilterX86();
+  template <X86_VEXT vext>
+  void _initLoopFilterX86();
+#endif
+
+private:
 #if JVET_K0251_QP_EXT
   static const uint8_t sm_tcTable[MAX_QP + 3];
   static const uint8_t sm_betaTable[MAX_QP + 1];
@@ -105,6 +125,9 @@ public:
   void loopFilterPic              ( CodingStructure& cs
                                     );
 
+  /// processing time of the last loopFilterPic call in seconds
+  double getPicProcessingTime     () const { return m_dPicProcessingTime; }
+
   static int getBeta              ( const int qp )
   {
     const int indexB = Clip3( 0, MAX_QP, qp );
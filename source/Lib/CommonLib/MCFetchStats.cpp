@@ -0,0 +1,129 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     MCFetchStats.cpp
+    \brief    run-time statistics of the motion compensation reference fetches
+*/
+
+#include "MCFetchStats.h"
+
+#include <cstdio>
+#include <cstring>
+
+//! \ingroup CommonLib
+//! \{
+
+static const char* const s_modelName[MC_FETCH_NUM_MODELS] = { "TRANS", "AFF4", "AFF6", "PERSP8" };
+
+static void printCounters( const char* name, const MCFetchStats::Counters& cnt )
+{
+  fprintf( stdout, " %-6s %9lld blocks %11lld samples  fetch ratio %5.2f  [", name, (long long) cnt.numBlocks, (long long) cnt.predicted, (double) cnt.fetched / cnt.predicted );
+  for( int i = 0; i < MC_FETCH_NUM_BUCKETS; i++ )
+  {
+    fprintf( stdout, " %5.1f", ( 100.0 * cnt.histogram[i] ) / cnt.numBlocks );
+  }
+  fprintf( stdout, " ] %%\n" );
+}
+
+MCFetchStats::MCFetchStats()
+  : m_poc    ( 0 )
+  , m_numPics( 0 )
+{
+  clear();
+  memset( m_seq, 0, sizeof( m_seq ) );
+}
+
+void MCFetchStats::clear()
+{
+  memset( m_pic, 0, sizeof( m_pic ) );
+}
+
+/** print the counters of the current picture, accumulate them to the sequence and reset them
+ */
+void MCFetchStats::reportPicture()
+{
+  bool any = false;
+
+  for( int m = 0; m < MC_FETCH_NUM_MODELS; m++ )
+  {
+    const Counters& pic = m_pic[m];
+    Counters&       seq = m_seq[m];
+
+    if( pic.numBlocks == 0 )
+    {
+      continue;
+    }
+    if( !any )
+    {
+      fprintf( stdout, "MC fetch POC %4d\n", m_poc );
+      any = true;
+    }
+    printCounters( s_modelName[m], pic );
+
+    seq.numBlocks += pic.numBlocks;
+    seq.predicted += pic.predicted;
+    seq.fetched   += pic.fetched;
+    for( int i = 0; i < MC_FETCH_NUM_BUCKETS; i++ )
+    {
+      seq.histogram[i] += pic.histogram[i];
+    }
+  }
+
+  m_numPics++;
+  clear();
+}
+
+void MCFetchStats::reportSequence()
+{
+  fprintf( stdout, "\nMC reference fetch statistics (%d pictures)\n", m_numPics );
+  fprintf( stdout, " fetch ratio histogram buckets: <1.5 <2 <3 <4 <6 >=6\n" );
+
+  int64_t predicted = 0;
+  int64_t fetched   = 0;
+
+  for( int m = 0; m < MC_FETCH_NUM_MODELS; m++ )
+  {
+    if( m_seq[m].numBlocks )
+    {
+      printCounters( s_modelName[m], m_seq[m] );
+      predicted += m_seq[m].predicted;
+      fetched   += m_seq[m].fetched;
+    }
+  }
+  if( predicted )
+  {
+    fprintf( stdout, " total  %11lld fetched samples, %.1f [MB] / picture\n", (long long) fetched, ( (double) fetched * sizeof( Pel ) ) / ( (double) std::max( m_numPics, 1 ) * 1024 * 1024 ) );
+  }
+}
+
+//! \}
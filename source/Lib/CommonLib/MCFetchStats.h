@@ -0,0 +1,113 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     MCFetchStats.h
+    \brief    run-time statistics of the motion compensation reference fetches (header)
+*/
+
+#ifndef __MCFETCHSTATS__
+#define __MCFETCHSTATS__
+
+#include "CommonDef.h"
+
+//! \ingroup CommonLib
+//! \{
+
+/// prediction model of a motion compensated block
+enum MCFetchModel
+{
+  MC_FETCH_TRANSLATIONAL = 0,
+  MC_FETCH_AFFINE_4PARAM,
+  MC_FETCH_AFFINE_6PARAM,
+  MC_FETCH_PERSPECTIVE_8PARAM,
+  MC_FETCH_NUM_MODELS
+};
+
+/// buckets of the ratio of fetched reference samples to predicted samples of a block
+enum MCFetchRatioBucket
+{
+  MC_FETCH_RATIO_1_5 = 0,   ///< < 1.5
+  MC_FETCH_RATIO_2,         ///< < 2
+  MC_FETCH_RATIO_3,         ///< < 3
+  MC_FETCH_RATIO_4,         ///< < 4
+  MC_FETCH_RATIO_6,         ///< < 6
+  MC_FETCH_RATIO_LARGE,     ///< >= 6
+  MC_FETCH_NUM_BUCKETS
+};
+
+/// reference fetch counters of the motion compensation, collected per picture and per sequence
+/** In contrast to the CacheModel no particular memory architecture is modelled: each motion compensated block
+ *  accounts for the reference samples its interpolation reads. The statistics are switched at run-time, the
+ *  prediction only tests a pointer when they are disabled.
+ */
+class MCFetchStats
+{
+public:
+  struct Counters
+  {
+    int64_t     numBlocks;                          ///< # of motion compensated blocks (per component)
+    int64_t     predicted;                          ///< predicted samples
+    int64_t     fetched;                            ///< reference samples read by the interpolation
+    int64_t     histogram[MC_FETCH_NUM_BUCKETS];    ///< # of blocks per fetch ratio bucket
+  };
+
+private:
+  Counters      m_pic[MC_FETCH_NUM_MODELS];
+  Counters      m_seq[MC_FETCH_NUM_MODELS];
+  int           m_poc;
+  int           m_numPics;
+
+public:
+  MCFetchStats();
+
+  void  clear         ();
+  void  setPOC        ( const int poc ) { m_poc = poc; }
+
+  void  addFetch      ( const MCFetchModel model, const int predicted, const int fetched )
+  {
+    Counters& cnt = m_pic[model];
+    cnt.numBlocks++;
+    cnt.predicted += predicted;
+    cnt.fetched   += fetched;
+    // fetch ratio in units of 0.5
+    const int ratio2 = ( fetched << 1 ) / predicted;
+    cnt.histogram[ratio2 < 3 ? MC_FETCH_RATIO_1_5 : ratio2 < 4 ? MC_FETCH_RATIO_2 : ratio2 < 6 ? MC_FETCH_RATIO_3 : ratio2 < 8 ? MC_FETCH_RATIO_4 : ratio2 < 12 ? MC_FETCH_RATIO_6 : MC_FETCH_RATIO_LARGE]++;
+  }
+
+  void  reportPicture ();
+  void  reportSequence();
+};
+
+//! \}
+
+#endif // __MCFETCHSTATS__
@@ -38,6 +38,11 @@
 //! \ingroup CommonLib
 //! \{
 
+#if ENABLE_PARALLEL_PICTURE_HASH
+/** pictures with fewer luma samples are hashed in a single thread, the thread start-up would outweigh the gain */
+static const int PIC_HASH_MIN_PARALLEL_AREA = 416 * 240;
+#endif
+
 /**
  * Update md5 using n samples from plane, each sample is adjusted to
  * OUTBIT_BITDEPTH_DIV8.
@@ -87,74 +92,125 @@ static void md5_plane(MD5& md5, const Pel* plane, uint32_t width, uint32_t heigh
 }
 
 
+/**
+ * Table of the CRC update for a byte shifted in msb first: shifting in the
+ * 8 bits of a byte b moves the low byte of the CRC up and xors in the
+ * remainder of the high byte, i.e. crc' = table[crc >> 8] ^ ((crc << 8) | b).
+ */
+struct CRCTable
+{
+  uint16_t entry[256];
+
+  CRCTable()
+  {
+    for (uint32_t i = 0; i < 256; i++)
+    {
+      uint32_t crcVal = i << 8;
+      for (uint32_t bitIdx = 0; bitIdx < 8; bitIdx++)
+      {
+        const uint32_t crcMsb = (crcVal >> 15) & 1;
+        crcVal = ((crcVal << 1) & 0xffff) ^ (crcMsb * 0x1021);
+      }
+      entry[i] = crcVal;
+    }
+  }
+};
+
+static const CRCTable g_crcTable;
+
+static inline uint32_t crcByte(uint32_t crcVal, uint32_t byte)
+{
+  return g_crcTable.entry[crcVal >> 8] ^ (((crcVal << 8) | byte) & 0xffff);
+}
+
 uint32_t compCRC(int bitdepth, const Pel* plane, uint32_t width, uint32_t height, uint32_t stride, PictureHash &digest)
 {
-  uint32_t crcMsb;
-  uint32_t bitVal;
   uint32_t crcVal = 0xffff;
-  uint32_t bitIdx;
-  for (uint32_t y = 0; y < height; y++)
+  for (uint32_t y = 0; y < height; y++, plane += stride)
   {
-    for (uint32_t x = 0; x < width; x++)
+    if (bitdepth > 8)
     {
-      // take CRC of first pictureData byte
-      for(bitIdx=0; bitIdx<8; bitIdx++)
+      // take CRC of both pictureData bytes, the low byte first
+      for (uint32_t x = 0; x < width; x++)
       {
-        crcMsb = (crcVal >> 15) & 1;
-        bitVal = (plane[y*stride+x] >> (7 - bitIdx)) & 1;
-        crcVal = (((crcVal << 1) + bitVal) & 0xffff) ^ (crcMsb * 0x1021);
+        crcVal = crcByte(crcVal,  plane[x]       & 0xff);
+        crcVal = crcByte(crcVal, (plane[x] >> 8) & 0xff);
       }
-      // take CRC of second pictureData byte if bit depth is greater than 8-bits
-      if(bitdepth > 8)
+    }
+    else
+    {
+      for (uint32_t x = 0; x < width; x++)
       {
-        for(bitIdx=0; bitIdx<8; bitIdx++)
-        {
-          crcMsb = (crcVal >> 15) & 1;
-          bitVal = (plane[y*stride+x] >> (15 - bitIdx)) & 1;
-          crcVal = (((crcVal << 1) + bitVal) & 0xffff) ^ (crcMsb * 0x1021);
-        }
+        crcVal = crcByte(crcVal, plane[x] & 0xff);
       }
     }
   }
-  for(bitIdx=0; bitIdx<16; bitIdx++)
-  {
-    crcMsb = (crcVal >> 15) & 1;
-    crcVal = ((crcVal << 1) & 0xffff) ^ (crcMsb * 0x1021);
-  }
+  crcVal = crcByte(crcVal, 0);
+  crcVal = crcByte(crcVal, 0);
 
   digest.hash.push_back((crcVal>>8)  & 0xff);
   digest.hash.push_back( crcVal      & 0xff);
   return 2;
 }
 
-uint32_t calcCRC(const CPelUnitBuf& pic, PictureHash &digest, const BitDepths &bitDepths)
+/**
+ * The plane digests are independent, they are computed in parallel and
+ * concatenated in component order.
+ */
+template<typename CompHashFunc>
+static void hashPlanes(const CPelUnitBuf& pic, PictureHash &digest, CompHashFunc compHash)
 {
-  uint32_t digestLen=0;
+  const int   numComp = (int) pic.bufs.size();
+  PictureHash compDigest[MAX_NUM_COMPONENT];
+
+#if ENABLE_PARALLEL_PICTURE_HASH
+#pragma omp parallel for schedule(dynamic,1) num_threads(numComp) if(pic.bufs[COMPONENT_Y].area() >= PIC_HASH_MIN_PARALLEL_AREA)
+#endif
+  for (int chan = 0; chan < numComp; chan++)
+  {
+    compHash(ComponentID(chan), compDigest[chan]);
+  }
+
   digest.hash.clear();
-  for (uint32_t chan = 0; chan< (uint32_t)pic.bufs.size(); chan++)
+  for (int chan = 0; chan < numComp; chan++)
   {
-    const ComponentID compID = ComponentID(chan);
-    const CPelBuf area = pic.get(compID);
-    digestLen = compCRC(bitDepths.recon[toChannelType(compID)], area.bufAt(0, 0), area.width, area.height, area.stride, digest );
+    digest.hash.insert(digest.hash.end(), compDigest[chan].hash.begin(), compDigest[chan].hash.end());
   }
-  return digestLen;
+}
+
+uint32_t calcCRC(const CPelUnitBuf& pic, PictureHash &digest, const BitDepths &bitDepths)
+{
+  hashPlanes(pic, digest, [&](const ComponentID compID, PictureHash &compDigest)
+  {
+    const CPelBuf area = pic.get(compID);
+    compCRC(bitDepths.recon[toChannelType(compID)], area.bufAt(0, 0), area.width, area.height, area.stride, compDigest);
+  });
+  return 2;
 }
 
 uint32_t compChecksum(int bitdepth, const Pel* plane, uint32_t width, uint32_t height, uint32_t stride, PictureHash &digest, const BitDepths &/*bitDepths*/)
 {
   uint32_t checksum = 0;
-  uint8_t xor_mask;
 
-  for (uint32_t y = 0; y < height; y++)
+  for (uint32_t y = 0; y < height; y++, plane += stride)
   {
-    for (uint32_t x = 0; x < width; x++)
-    {
-      xor_mask = (x & 0xff) ^ (y & 0xff) ^ (x >> 8) ^ (y >> 8);
-      checksum = (checksum + ((plane[y*stride+x] & 0xff) ^ xor_mask)) & 0xffffffff;
+    const uint32_t yMask = (y & 0xff) ^ (y >> 8);
 
-      if(bitdepth > 8)
+    // the sum wraps around at 32 bits, the row loops are free of dependencies besides it
+    if (bitdepth > 8)
+    {
+      for (uint32_t x = 0; x < width; x++)
       {
-        checksum = (checksum + ((plane[y*stride+x]>>8) ^ xor_mask)) & 0xffffffff;
+        const uint32_t xor_mask = ((x & 0xff) ^ (x >> 8) ^ yMask) & 0xff;
+        checksum += ((plane[x] & 0xff) ^ xor_mask) + (((plane[x] >> 8) & 0xff) ^ xor_mask);
+      }
+    }
+    else
+    {
+      for (uint32_t x = 0; x < width; x++)
+      {
+        const uint32_t xor_mask = ((x & 0xff) ^ (x >> 8) ^ yMask) & 0xff;
+        checksum += (plane[x] & 0xff) ^ xor_mask;
       }
     }
   }
@@ -168,15 +224,12 @@ uint32_t compChecksum(int bitdepth, const Pel* plane, uint32_t width, uint32_t h
 
 uint32_t calcChecksum(const CPelUnitBuf& pic, PictureHash &digest, const BitDepths &bitDepths)
 {
-  uint32_t digestLen=0;
-  digest.hash.clear();
-  for(uint32_t chan=0; chan< (uint32_t)pic.bufs.size(); chan++)
+  hashPlanes(pic, digest, [&](const ComponentID compID, PictureHash &compDigest)
   {
-    const ComponentID compID=ComponentID(chan);
     const CPelBuf area = pic.get(compID);
-    digestLen=compChecksum(bitDepths.recon[toChannelType(compID)], area.bufAt(0,0), area.width, area.height, area.stride, digest, bitDepths);
-  }
-  return digestLen;
+    compChecksum(bitDepths.recon[toChannelType(compID)], area.bufAt(0,0), area.width, area.height, area.stride, compDigest, bitDepths);
+  });
+  return 4;
 }
 /**
  * Calculate the MD5sum of pic, storing the result in digest.
@@ -189,25 +242,17 @@ uint32_t calcMD5(const CPelUnitBuf& pic, PictureHash &digest, const BitDepths &b
 {
   /* choose an md5_plane packing function based on the system bitdepth */
   typedef void (*MD5PlaneFunc)(MD5&, const Pel*, uint32_t, uint32_t, uint32_t);
-  MD5PlaneFunc md5_plane_func;
 
-  MD5 md5[MAX_NUM_COMPONENT];
-
-  digest.hash.clear();
-
-  for (uint32_t chan = 0; chan< (uint32_t)pic.bufs.size(); chan++)
+  hashPlanes(pic, digest, [&](const ComponentID compID, PictureHash &compDigest)
   {
-    const ComponentID compID=ComponentID(chan);
     const CPelBuf area = pic.get(compID);
-    md5_plane_func = bitDepths.recon[toChannelType(compID)] <= 8 ? (MD5PlaneFunc)md5_plane<1> : (MD5PlaneFunc)md5_plane<2>;
+    MD5PlaneFunc md5_plane_func = bitDepths.recon[toChannelType(compID)] <= 8 ? (MD5PlaneFunc)md5_plane<1> : (MD5PlaneFunc)md5_plane<2>;
+    MD5     md5;
     uint8_t tmp_digest[MD5_DIGEST_STRING_LENGTH];
-    md5_plane_func(md5[compID], area.bufAt(0, 0), area.width, area.height, area.stride );
-    md5[compID].finalize(tmp_digest);
-    for(uint32_t i=0; i<MD5_DIGEST_STRING_LENGTH; i++)
-    {
-      digest.hash.push_back(tmp_digest[i]);
-    }
-  }
+    md5_plane_func(md5, area.bufAt(0, 0), area.width, area.height, area.stride );
+    md5.finalize(tmp_digest);
+    compDigest.hash.assign(tmp_digest, tmp_digest + MD5_DIGEST_STRING_LENGTH);
+  });
   return 16;
 }
 
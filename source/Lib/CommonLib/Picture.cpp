@@ -761,6 +761,11 @@ void Picture::destroy()
     M_BUFS( jId, t ).destroy();
   }
 
+  for( int level = 0; level < NUM_ORIG_PYRAMID_LEVELS; level++ )
+  {
+    m_origPyramid[level].destroy();
+  }
+
   if( cs )
   {
     cs->destroy();
@@ -839,6 +844,57 @@ const CPelUnitBuf Picture::getOrigBuf(const UnitArea &unit) const { return getBu
        PelUnitBuf Picture::getOrigBuf()                           { return M_BUFS(0,    PIC_ORIGINAL); }
 const CPelUnitBuf Picture::getOrigBuf()                     const { return M_BUFS(0,    PIC_ORIGINAL); }
 
+void Picture::createOrigPyramid()
+{
+  CPelBuf src = getOrigBuf().Y();
+
+  for( int level = 0; level < NUM_ORIG_PYRAMID_LEVELS; level++ )
+  {
+    const int width  = ( src.width  + 1 ) >> 1;
+    const int height = ( src.height + 1 ) >> 1;
+
+    if( m_origPyramid[level].bufs.empty() )
+    {
+      m_origPyramid[level].create( CHROMA_400, Area( 0, 0, width, height ) );
+    }
+
+    // 2x2 average, replicating the last row and column for odd sizes
+    PelBuf dst = m_origPyramid[level].getBuf( COMPONENT_Y );
+    for( int y = 0; y < height; y++ )
+    {
+      const Pel* pSrc0 = src.bufAt( 0, std::min<int>( 2 * y,     src.height - 1 ) );
+      const Pel* pSrc1 = src.bufAt( 0, std::min<int>( 2 * y + 1, src.height - 1 ) );
+      Pel*       pDst  = dst.bufAt( 0, y );
+
+      for( int x = 0; x < width; x++ )
+      {
+        const int x0 = std::min<int>( 2 * x,     src.width - 1 );
+        const int x1 = std::min<int>( 2 * x + 1, src.width - 1 );
+        pDst[x] = ( pSrc0[x0] + pSrc0[x1] + pSrc1[x0] + pSrc1[x1] + 2 ) >> 2;
+      }
+    }
+
+    src = dst;
+  }
+}
+
+bool Picture::getPreSearchMv( const RefPicList refList, const int refIdx, const Position& pos, Mv& mv ) const
+{
+  const std::vector<Mv>& field = m_preSearchMv[refList][refIdx];
+
+  if( field.empty() )
+  {
+    return false;
+  }
+
+  const int widthInBlks = ( lwidth() + PRE_SEARCH_BLK_SIZE - 1 ) / PRE_SEARCH_BLK_SIZE;
+  const int blkX        = std::min<int>( pos.x, lwidth()  - 1 ) / PRE_SEARCH_BLK_SIZE;
+  const int blkY        = std::min<int>( pos.y, lheight() - 1 ) / PRE_SEARCH_BLK_SIZE;
+
+  mv = field[blkY * widthInBlks + blkX];
+  return true;
+}
+
        PelBuf     Picture::getPredBuf(const CompArea &blk)        { return getBuf(blk,  PIC_PREDICTION); }
 const CPelBuf     Picture::getPredBuf(const CompArea &blk)  const { return getBuf(blk,  PIC_PREDICTION); }
        PelUnitBuf Picture::getPredBuf(const UnitArea &unit)       { return getBuf(unit, PIC_PREDICTION); }
@@ -858,7 +914,7 @@ const CPelUnitBuf Picture::getRecoBuf(const UnitArea &unit)     const { return g
        PelUnitBuf Picture::getRecoBuf()                               { return M_BUFS(scheduler.getSplitPicId(), PIC_RECONSTRUCTION); }
 const CPelUnitBuf Picture::getRecoBuf()                         const { return M_BUFS(scheduler.getSplitPicId(), PIC_RECONSTRUCTION); }
 
-void Picture::finalInit( const SPS& sps, const PPS& pps )
+void Picture::finalInit( const SPS& sps, const PPS& pps, XUCache& unitCache )
 {
   for( auto &sei : SEIs )
   {
@@ -886,7 +942,7 @@ void Picture::finalInit( const SPS& sps, const PPS& pps )
   }
   else
   {
-    cs = new CodingStructure( g_globalUnitCache.cuCache, g_globalUnitCache.puCache, g_globalUnitCache.tuCache );
+    cs = new CodingStructure( unitCache.cuCache, unitCache.puCache, unitCache.tuCache );
     cs->sps = &sps;
     cs->create( chromaFormatIDC, Area( 0, 0, iWidth, iHeight ), true );
   }
@@ -985,37 +1041,10 @@ void Picture::extendPicBorder()
   {
     ComponentID compID = ComponentID( comp );
     PelBuf p = M_BUFS( 0, PIC_RECONSTRUCTION ).get( compID );
-    Pel *piTxt = p.bufAt(0,0);
     int xmargin = margin >> getComponentScaleX( compID, cs->area.chromaFormat );
     int ymargin = margin >> getComponentScaleY( compID, cs->area.chromaFormat );
 
-    Pel*  pi = piTxt;
-    // do left and right margins
-    for (int y = 0; y < p.height; y++)
-    {
-      for (int x = 0; x < xmargin; x++ )
-      {
-        pi[ -xmargin + x ] = pi[0];
-        pi[  p.width + x ] = pi[p.width-1];
-      }
-      pi += p.stride;
-    }
-
-    // pi is now the (0,height) (bottom left of image within bigger picture
-    pi -= (p.stride + xmargin);
-    // pi is now the (-marginX, height-1)
-    for (int y = 0; y < ymargin; y++ )
-    {
-      ::memcpy( pi + (y+1)*p.stride, pi, sizeof(Pel)*(p.width + (xmargin << 1)));
-    }
-
-    // pi is still (-marginX, height-1)
-    pi -= ((p.height-1) * p.stride);
-    // pi is now (-marginX, 0)
-    for (int y = 0; y < ymargin; y++ )
-    {
-      ::memcpy( pi - (y+1)*p.stride, pi, sizeof(Pel)*(p.width + (xmargin<<1)) );
-    }
+    p.extendBorderPel( xmargin, ymargin );
   }
 
   m_bIsBorderExtended = true;
@@ -193,6 +193,14 @@ struct Picture : public UnitArea
          PelUnitBuf getOrigBuf();
   const CPelUnitBuf getOrigBuf() const;
 
+  static const int NUM_ORIG_PYRAMID_LEVELS = 2;
+  static const int PRE_SEARCH_BLK_SIZE     = 16;
+
+  void              createOrigPyramid();
+  bool              hasOrigPyramid()                          const { return !m_origPyramid[0].bufs.empty(); }
+  const CPelBuf     getOrigPyramidBuf( const int level )      const { return m_origPyramid[level].getBuf( COMPONENT_Y ); }
+  bool              getPreSearchMv( const RefPicList refList, const int refIdx, const Position& pos, Mv& mv ) const;
+
          PelBuf     getPredBuf(const CompArea &blk);
   const CPelBuf     getPredBuf(const CompArea &blk) const;
          PelUnitBuf getPredBuf(const UnitArea &unit);
@@ -220,7 +228,7 @@ struct Picture : public UnitArea
   const CPelUnitBuf getBuf(const UnitArea &unit,     const PictureType &type) const;
 
   void extendPicBorder();
-  void finalInit( const SPS& sps, const PPS& pps );
+  void finalInit( const SPS& sps, const PPS& pps, XUCache& unitCache = g_globalUnitCache );
 
   int  getPOC()                               const { return poc; }
   void setBorderExtension( bool bFlag)              { m_bIsBorderExtended = bFlag;}
@@ -262,6 +270,9 @@ public:
   TileMap*     tileMap;
 #endif
   std::vector<AQpLayer*> aqlayer;
+  std::vector<double>    m_lookaheadCostCtu;                      ///< CTU-wise lookahead complexity for rate control, empty when not analysed
+  std::vector<Mv>        m_preSearchMv[NUM_REF_PIC_LIST_01][MAX_NUM_REF]; ///< integer-pel MVs of the hierarchical motion pre-search per PRE_SEARCH_BLK_SIZE luma block
+  PelStorage             m_origPyramid[NUM_ORIG_PYRAMID_LEVELS];  ///< source luma downsampled by 2 and by 4 in each direction
 
 #if !KEEP_PRED_AND_RESI_SIGNALS
 private:
@@ -49,6 +49,7 @@
 
 
 FpDistFunc RdCost::m_afpDistortFunc[DF_TOTAL_FUNCTIONS] = { nullptr, };
+FpDistFuncMulti RdCost::m_afpDistortFuncMulti[DF_TOTAL_FUNCTIONS] = { nullptr, };
 
 RdCost::RdCost()
 {
@@ -172,6 +173,11 @@ void RdCost::init()
   m_afpDistortFunc[DF_SSE16N_WTD] = RdCost::xGetSSE16N_WTD;
 #endif
 
+  for( int i = 0; i < DF_TOTAL_FUNCTIONS; i++ )
+  {
+    m_afpDistortFuncMulti[i] = RdCost::xGetDistMulti;
+  }
+
 #if ENABLE_SIMD_OPT_DIST
 #ifdef TARGET_SIMD_X86
   initRdCostX86();
@@ -225,31 +231,38 @@ void RdCost::setDistParam( DistParam &rcDP, const CPelBuf &org, const Pel* piRef
     if( org.width == 12 )
     {
       rcDP.distFunc = m_afpDistortFunc[ DF_SAD12 + DFOffset ];
+      rcDP.distFuncMulti = m_afpDistortFuncMulti[ DF_SAD12 + DFOffset ];
     }
     else if( org.width == 24 )
     {
       rcDP.distFunc = m_afpDistortFunc[ DF_SAD24 + DFOffset ];
+      rcDP.distFuncMulti = m_afpDistortFuncMulti[ DF_SAD24 + DFOffset ];
     }
     else if( org.width == 48 )
     {
       rcDP.distFunc = m_afpDistortFunc[ DF_SAD48 + DFOffset ];
+      rcDP.distFuncMulti = m_afpDistortFuncMulti[ DF_SAD48 + DFOffset ];
     }
     else if( isPowerOf2( org.width ) )
     {
       rcDP.distFunc = m_afpDistortFunc[ DF_SAD + DFOffset + g_aucLog2[ org.width ] ];
+      rcDP.distFuncMulti = m_afpDistortFuncMulti[ DF_SAD + DFOffset + g_aucLog2[ org.width ] ];
     }
     else
     {
       rcDP.distFunc = m_afpDistortFunc[ DF_SAD + DFOffset ];
+      rcDP.distFuncMulti = m_afpDistortFuncMulti[ DF_SAD + DFOffset ];
     }
   }
   else if( isPowerOf2( org.width ) )
   {
     rcDP.distFunc = m_afpDistortFunc[ DF_HAD + DFOffset + g_aucLog2[ org.width ] ];
+    rcDP.distFuncMulti = m_afpDistortFuncMulti[ DF_HAD + DFOffset + g_aucLog2[ org.width ] ];
   }
   else
   {
     rcDP.distFunc = m_afpDistortFunc[ DF_HAD + DFOffset ];
+    rcDP.distFuncMulti = m_afpDistortFuncMulti[ DF_HAD + DFOffset ];
   }
 
   // initialize
@@ -300,27 +313,33 @@ void RdCost::setDistParam( DistParam &rcDP, const CPelBuf &org, const CPelBuf &c
     if( org.width == 12 )
     {
       rcDP.distFunc = m_afpDistortFunc[ DF_SAD12 + DFOffset ];
+      rcDP.distFuncMulti = m_afpDistortFuncMulti[ DF_SAD12 + DFOffset ];
     }
     else if( org.width == 24 )
     {
       rcDP.distFunc = m_afpDistortFunc[ DF_SAD24 + DFOffset ];
+      rcDP.distFuncMulti = m_afpDistortFuncMulti[ DF_SAD24 + DFOffset ];
     }
     else if( org.width == 48 )
     {
       rcDP.distFunc = m_afpDistortFunc[ DF_SAD48 + DFOffset ];
+      rcDP.distFuncMulti = m_afpDistortFuncMulti[ DF_SAD48 + DFOffset ];
     }
     else if( isPowerOf2( org.width) )
     {
       rcDP.distFunc = m_afpDistortFunc[ DF_SAD + DFOffset + g_aucLog2[ org.width ] ];
+      rcDP.distFuncMulti = m_afpDistortFuncMulti[ DF_SAD + DFOffset + g_aucLog2[ org.width ] ];
     }
     else
     {
       rcDP.distFunc = m_afpDistortFunc[ DF_SAD + DFOffset ];
+      rcDP.distFuncMulti = m_afpDistortFuncMulti[ DF_SAD + DFOffset ];
     }
   }
   else
   {
     rcDP.distFunc = m_afpDistortFunc[ DF_HAD + DFOffset + g_aucLog2[ org.width ] ];
+    rcDP.distFuncMulti = m_afpDistortFuncMulti[ DF_HAD + DFOffset + g_aucLog2[ org.width ] ];
   }
 
   rcDP.maximumDistortionForEarlyExit = std::numeric_limits<Distortion>::max();
@@ -350,18 +369,22 @@ void RdCost::setDistParam( DistParam &rcDP, const Pel* pOrg, const Pel* piRefY,
   if( width == 12 )
   {
     rcDP.distFunc = m_afpDistortFunc[ DF_SAD12 ];
+    rcDP.distFuncMulti = m_afpDistortFuncMulti[ DF_SAD12 ];
   }
   else if( width == 24 )
   {
     rcDP.distFunc = m_afpDistortFunc[ DF_SAD24 ];
+    rcDP.distFuncMulti = m_afpDistortFuncMulti[ DF_SAD24 ];
   }
   else if( width == 48 )
   {
     rcDP.distFunc = m_afpDistortFunc[ DF_SAD48 ];
+    rcDP.distFuncMulti = m_afpDistortFuncMulti[ DF_SAD48 ];
   }
   else
   {
     rcDP.distFunc = m_afpDistortFunc[ DF_SAD + g_aucLog2[ width ] ];
+    rcDP.distFuncMulti = m_afpDistortFuncMulti[ DF_SAD + g_aucLog2[ width ] ];
   }
 }
 
@@ -2973,6 +2996,18 @@ Distortion RdCost::xGetHADs( const DistParam &rcDtParam )
 #endif
 }
 
+// generic multi-candidate distortion: one distFunc call per candidate, no early exit between them
+void RdCost::xGetDistMulti( const DistParam &rcDtParam, const Pel* const* curBufs, int numCur, Distortion* dist )
+{
+  DistParam cDtParam = rcDtParam;
+
+  for( int i = 0; i < numCur; i++ )
+  {
+    cDtParam.cur.buf = curBufs[i];
+    dist[i]          = cDtParam.distFunc( cDtParam );
+  }
+}
+
 
 #if WCG_EXT
 double RdCost::m_lumaLevelToWeightPLUT[LUMA_LEVEL_TO_DQP_LUT_MAXSIZE];
@@ -58,6 +58,8 @@ class EncCfg;
 
 // for function pointer
 typedef Distortion (*FpDistFunc) (const DistParam&);
+// scores several candidate blocks (cur.buf replaced by each pointer) against the same original
+typedef void       (*FpDistFuncMulti) (const DistParam&, const Pel* const*, int, Distortion*);
 
 // ====================================================================================================================
 // Class definition
@@ -74,6 +76,7 @@ public:
 #endif
   int                   step;
   FpDistFunc            distFunc;
+  FpDistFuncMulti       distFuncMulti;
   int                   bitDepth;
 
   bool                  useMR;
@@ -89,7 +92,7 @@ public:
   // - 0 = no subsampling, 1 = even rows, 2 = every 4th, etc.
   int                   subShift;
 
-  DistParam() : org(), cur(), step( 1 ), bitDepth( 0 ), useMR( false ), applyWeight( false ), isBiPred( false ), wpCur( nullptr ), compID( MAX_NUM_COMPONENT ), maximumDistortionForEarlyExit( std::numeric_limits<Distortion>::max() ), subShift( 0 ) { }
+  DistParam() : org(), cur(), step( 1 ), distFuncMulti( nullptr ), bitDepth( 0 ), useMR( false ), applyWeight( false ), isBiPred( false ), wpCur( nullptr ), compID( MAX_NUM_COMPONENT ), maximumDistortionForEarlyExit( std::numeric_limits<Distortion>::max() ), subShift( 0 ) { }
 };
 
 /// RD cost computation class
@@ -99,6 +102,7 @@ private:
   // for distortion
 
   static FpDistFunc       m_afpDistortFunc[DF_TOTAL_FUNCTIONS]; // [eDFunc]
+  static FpDistFuncMulti  m_afpDistortFuncMulti[DF_TOTAL_FUNCTIONS]; // [eDFunc]
   CostMode                m_costMode;
   double                  m_distortionWeight[MAX_NUM_COMPONENT]; // only chroma values are used.
   double                  m_dLambda;
@@ -153,6 +157,7 @@ public:
   void           setDistParam( DistParam &rcDP, const CPelBuf &org, const Pel* piRefY , int iRefStride, int bitDepth, ComponentID compID, int subShiftMode = 0, int step = 1, bool useHadamard = false );
   void           setDistParam( DistParam &rcDP, const CPelBuf &org, const CPelBuf &cur, int bitDepth, ComponentID compID, bool useHadamard = false );
   void           setDistParam( DistParam &rcDP, const Pel* pOrg, const Pel* piRefY, int iOrgStride, int iRefStride, int bitDepth, ComponentID compID, int width, int height, int subShiftMode = 0, int step = 1, bool useHadamard = false );
+  static bool    isDistMultiBatched( const DistParam &rcDP ) { return rcDP.distFuncMulti != xGetDistMulti; }
 
   double         getMotionLambda          ( bool bIsTransquantBypass ) { return m_dLambdaMotionSAD[(bIsTransquantBypass && m_costMode==COST_MIXED_LOSSLESS_LOSSY_CODING)?1:0]; }
   void           selectMotionLambda       ( bool bIsTransquantBypass ) { m_motionLambda = getMotionLambda( bIsTransquantBypass ); }
@@ -249,6 +254,7 @@ private:
   static Distortion xGetMRHADs        ( const DistParam& pcDtParam );
 
   static Distortion xGetHADs          ( const DistParam& pcDtParam );
+  static void       xGetDistMulti     ( const DistParam& pcDtParam, const Pel* const* curBufs, int numCur, Distortion* dist );
   static Distortion xCalcHADs2x2      ( const Pel *piOrg, const Pel *piCurr, int iStrideOrg, int iStrideCur, int iStep );
   static Distortion xCalcHADs4x4      ( const Pel *piOrg, const Pel *piCurr, int iStrideOrg, int iStrideCur, int iStep );
   static Distortion xCalcHADs8x8      ( const Pel *piOrg, const Pel *piCurr, int iStrideOrg, int iStrideCur, int iStep );
@@ -271,6 +277,8 @@ private:
 
   template< typename Torg, typename Tcur, X86_VEXT vext >
   static Distortion xGetHADs_SIMD   ( const DistParam& pcDtParam );
+  template< X86_VEXT vext >
+  static void       xGetHADsMulti_SIMD( const DistParam& pcDtParam, const Pel* const* curBufs, int numCur, Distortion* dist );
 #endif
 
 public:
@@ -186,9 +186,17 @@ const int g_aiNonLMPosThrs[] = {  3,  1,  0 };
 #endif
 
 
+// number of initROM() calls not yet matched by destroyROM(), several encoders may share the tables
+static int s_romRefCount = 0;
+
 // initialize ROM variables
 void initROM()
 {
+  if( s_romRefCount++ > 0 )
+  {
+    return;
+  }
+
   int i, c;
 
 #if RExt__HIGH_BIT_DEPTH_SUPPORT
@@ -410,6 +418,11 @@ void initROM()
 
 void destroyROM()
 {
+  if( --s_romRefCount > 0 )
+  {
+    return;
+  }
+
   unsigned numWidths = gp_sizeIdxInfo->numAllWidths();
   unsigned numHeights = gp_sizeIdxInfo->numAllHeights();
 
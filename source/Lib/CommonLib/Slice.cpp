@@ -1619,6 +1619,7 @@ SPSNext::SPSNext( SPS& sps )
 #if JVET_K0337_AFFINE_6PARA
   , m_AffineType                ( 0 )
 #endif
+  , m_AffineAdaptiveSubblock    ( false )
 #endif
   , m_MTTEnabled                ( false )
 #if ENABLE_WPP_PARALLELISM
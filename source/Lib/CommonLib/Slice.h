@@ -827,6 +827,7 @@ private:
 #if JVET_K0337_AFFINE_6PARA
   int               m_AffineType;
 #endif
+  bool              m_AffineAdaptiveSubblock;
 #endif
   bool              m_MTTEnabled;                 //
 #if ENABLE_WPP_PARALLELISM
@@ -834,7 +835,7 @@ private:
 #endif
 
 public:
-  const static int  NumReservedFlags = 32 - 27; /* current number of tool enabling flags */
+  const static int  NumReservedFlags = 32 - 28; /* current number of tool enabling flags */
 
 private:
   //=====  additional parameters  =====
@@ -890,6 +891,8 @@ public:
   void      setUseAffineType      ( int b )                                        { m_AffineType = b; }
   int       getUseAffineType      ()                                      const     { return m_AffineType; }
 #endif
+  void      setUseAffineAdaptiveSubblock( bool b )                                  { m_AffineAdaptiveSubblock = b; }
+  bool      getUseAffineAdaptiveSubblock()                                const     { return m_AffineAdaptiveSubblock; }
 #endif
 #if JVET_K0072
 #else
@@ -0,0 +1,117 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     ToolTimer.cpp
+    \brief    run-time timers and counters of the coding tools
+*/
+
+#include "ToolTimer.h"
+
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//! \ingroup CommonLib
+//! \{
+
+static const char* const s_toolName[NUM_TOOL_TIMERS] =
+{
+  "tz_search",
+  "affine_me_4param",
+  "affine_me_6param",
+  "perspective_me",
+  "intra_search",
+  "intra_residual",
+  "inter_residual",
+  "deblocking",
+  "sao",
+  "alf",
+};
+
+bool ToolTimer::s_enabled = false;
+
+static std::mutex                                       s_countersMutex;
+static std::vector<std::unique_ptr<ToolTimer::Counters>> s_threadCounters;
+
+/** get the counters of the calling thread, they are created on the first use and live until the program ends
+ */
+ToolTimer::Counters& ToolTimer::getCounters()
+{
+  static thread_local Counters* counters = nullptr;
+
+  if( !counters )
+  {
+    std::lock_guard<std::mutex> lock( s_countersMutex );
+    s_threadCounters.emplace_back( new Counters );
+    counters = s_threadCounters.back().get();
+    memset( counters, 0, sizeof( Counters ) );
+  }
+  return *counters;
+}
+
+/** write the counters of all threads as JSON object
+ */
+void ToolTimer::writeReport( std::ostream& os, const double totalSecs )
+{
+  Counters    sum;
+  std::size_t numThreads;
+  memset( &sum, 0, sizeof( sum ) );
+
+  {
+    std::lock_guard<std::mutex> lock( s_countersMutex );
+    numThreads = s_threadCounters.size();
+    for( const auto& cnt : s_threadCounters )
+    {
+      for( int i = 0; i < NUM_TOOL_TIMERS; i++ )
+      {
+        sum.calls     [i] += cnt->calls     [i];
+        sum.nanoSecs  [i] += cnt->nanoSecs  [i];
+        sum.iterations[i] += cnt->iterations[i];
+      }
+    }
+  }
+
+  os << "{\n";
+  os << "  \"total_time_s\": " << totalSecs << ",\n";
+  os << "  \"threads\": " << numThreads << ",\n";
+  os << "  \"tools\": {\n";
+  for( int i = 0; i < NUM_TOOL_TIMERS; i++ )
+  {
+    os << "    \"" << s_toolName[i] << "\": { \"calls\": " << sum.calls[i] << ", \"time_s\": " << sum.nanoSecs[i] * 1e-9 << ", \"iterations\": " << sum.iterations[i] << " }" << ( i + 1 < NUM_TOOL_TIMERS ? ",\n" : "\n" );
+  }
+  os << "  }\n";
+  os << "}\n";
+}
+
+//! \}
@@ -0,0 +1,138 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     ToolTimer.h
+    \brief    run-time timers and counters of the coding tools (header)
+*/
+
+#ifndef __TOOLTIMER__
+#define __TOOLTIMER__
+
+#include "CommonDef.h"
+
+#include <chrono>
+#include <ostream>
+
+//! \ingroup CommonLib
+//! \{
+
+#if ENABLE_TOOL_TIMING
+#define TOOL_TIMER( tool )                  ToolTimerScope toolTimerScope( tool )
+#define TOOL_TIMER_ITERATIONS( tool, num )  ToolTimer::addIterations( tool, num )
+#else
+#define TOOL_TIMER( tool )                  /* do nothing */
+#define TOOL_TIMER_ITERATIONS( tool, num )  /* do nothing */
+#endif
+
+/// timed coding tools, the times of nested tools are included in the time of the enclosing tool
+/// the residual coding (transform, RDOQ/DQ and rate estimation) is timed per RD check of a CU, as timers per TU
+/// and component would cost more than 1% of the encoding time
+enum ToolTimerId
+{
+  TOOL_TZ_SEARCH = 0,
+  TOOL_AFFINE_ME_4PARAM,
+  TOOL_AFFINE_ME_6PARAM,
+  TOOL_PERSPECTIVE_ME,
+  TOOL_INTRA_SEARCH,
+  TOOL_INTRA_RESIDUAL,
+  TOOL_INTER_RESIDUAL,
+  TOOL_DEBLOCKING,
+  TOOL_SAO,
+  TOOL_ALF,
+  NUM_TOOL_TIMERS
+};
+
+/// global switch and report of the tool timers
+/** The counters are kept per thread and summed up for the report, so the timers can be used from concurrently
+ *  running encoder instances without synchronization. When disabled, a timer only tests a flag.
+ */
+class ToolTimer
+{
+public:
+  struct Counters
+  {
+    int64_t     calls     [NUM_TOOL_TIMERS];
+    int64_t     nanoSecs  [NUM_TOOL_TIMERS];
+    int64_t     iterations[NUM_TOOL_TIMERS];
+  };
+
+  static void       setEnabled    ( bool enabled )  { s_enabled = enabled; }
+  static bool       isEnabled     ()                { return s_enabled; }
+  static Counters&  getCounters   ();
+
+  static void       addIterations ( const ToolTimerId tool, const int num )
+  {
+    if( s_enabled )
+    {
+      getCounters().iterations[tool] += num;
+    }
+  }
+
+  static void       writeReport   ( std::ostream& os, const double totalSecs );
+
+private:
+  static bool       s_enabled;
+};
+
+/// accounts the life time of the scope to a tool
+class ToolTimerScope
+{
+  const ToolTimerId                                   m_tool;
+  const bool                                          m_enabled;
+  std::chrono::time_point<std::chrono::steady_clock>  m_start;
+
+public:
+  ToolTimerScope( const ToolTimerId tool )
+    : m_tool   ( tool )
+    , m_enabled( ToolTimer::isEnabled() )
+  {
+    if( m_enabled )
+    {
+      m_start = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~ToolTimerScope()
+  {
+    if( m_enabled )
+    {
+      ToolTimer::Counters& cnt = ToolTimer::getCounters();
+      cnt.calls   [m_tool]++;
+      cnt.nanoSecs[m_tool] += std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - m_start ).count();
+    }
+  }
+};
+
+//! \}
+
+#endif // __TOOLTIMER__
@@ -187,6 +187,14 @@
 
 #define KEEP_PRED_AND_RESI_SIGNALS                        0
 
+#define ENABLE_FAST_RATE_ESTIMATION                       1 ///< devirtualized bit estimation for residual, last position and mvd coding in RD mode, no impact on RD performance
+#define ENABLE_FAST_RATE_ESTIMATION_CHECK                 0 ///< re-run every devirtualized estimation through the virtual bin encoder interface and check that the fractional bits and context states match (slow, for verification)
+#define ENABLE_AFFINE_MC_REF_TILE                         1 ///< fetch the reference footprint of an affine PU once into a local tile for the sub-block interpolation, no impact on RD performance
+#define ENABLE_TOOL_TIMING                                1 ///< scoped run-time timers and counters of the major coding tools, reported as JSON, no impact on RD performance
+#define ENABLE_COMPRESSED_COL_MOTION                      1 ///< keep a copy of the motion field of finished pictures on the motion compression grid for the collocated fetches, no impact on RD performance
+#define ENABLE_HALF_PEL_PLANE_CACHE                       1 ///< interpolate the half-sample planes of the references once per CTU and tile for the fractional-pel ME, no impact on RD performance
+#define ENABLE_PARALLEL_PICTURE_HASH                      1 ///< compute the decoded picture hash of the colour planes in parallel threads, no impact on RD performance
+
 #define ENABLE_BMS                                        1
 
 #if QTBT_AS_IN_JEM // macros which will cause changes in the decoder behavior ara marked with *** - keep them on to retain compatibility with JEM-toolcheck
@@ -274,12 +282,15 @@
 #define ENABLE_SIMD_OPT_MCIF                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the interpolation filter, no impact on RD performance
 #define ENABLE_SIMD_OPT_BUFFER                          ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the buffer operations, no impact on RD performance
 #define ENABLE_SIMD_OPT_DIST                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the distortion calculations(SAD,SSE,HADAMARD), no impact on RD performance
+#define ENABLE_SIMD_OPT_DIST_MULTI                      ( 1 && ENABLE_SIMD_OPT_DIST )                       ///< 16-bit 8x8 HADAMARD kernels and multi-candidate scoring, no impact on RD performance
 #if JVET_K0367_AFFINE_FIX_POINT
 #define ENABLE_SIMD_OPT_AFFINE_ME                       ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for affine ME, no impact on RD performance
 #endif
 #if JVET_K0371_ALF
 #define ENABLE_SIMD_OPT_ALF                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for ALF
 #endif
+#define ENABLE_SIMD_OPT_DBLF                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the deblocking filter, no impact on RD performance
+#define ENABLE_SIMD_OPT_INTRAPRED                       ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the intra prediction, no impact on RD performance
 // End of SIMD optimizations
 
 
@@ -1030,6 +1041,14 @@ struct LFCUParam
   bool topEdge;                          ///< indicates top edge
 };
 
+struct LFSegParam
+{
+  int  tc;                               ///< tc value of the segment, 0 leaves the segment unfiltered
+  int  beta;                             ///< beta value of the segment (luma only)
+  bool partPNoFilter;                    ///< indicator to disable filtering on partP
+  bool partQNoFilter;                    ///< indicator to disable filtering on partQ
+};
+
 
 
 struct PictureHash
@@ -341,13 +341,10 @@ void PredictionUnit::initData()
     for( uint32_t j = 0; j < 4; j++ )
     {
       mvdAffi[i][j].setZero();
+      mvAffi [i][j].setZero();
     }
 #endif
   }
-  for (uint32_t i = 0; i < 2; i++)
-  {
-	  perspParam[i] = 0.0;
-  }
 }
 
 PredictionUnit& PredictionUnit::operator=(const IntraPredictionData& predData)
@@ -377,6 +374,7 @@ PredictionUnit& PredictionUnit::operator=(const InterPredictionData& predData)
     for( uint32_t j = 0; j < 4; j++ )
     {
       mvdAffi[i][j] = predData.mvdAffi[i][j];
+      mvAffi [i][j] = predData.mvAffi [i][j];
     }
 #endif
   }
@@ -406,6 +404,7 @@ PredictionUnit& PredictionUnit::operator=( const PredictionUnit& other )
     for( uint32_t j = 0; j < 4; j++ )
     {
       mvdAffi[i][j] = other.mvdAffi[i][j];
+      mvAffi [i][j] = other.mvAffi [i][j];
     }
 #endif
   }
@@ -514,7 +513,8 @@ TransformUnit& TransformUnit::operator=(const TransformUnit& other)
 
     uint32_t area = blocks[i].area();
 
-    if (m_coeffs[i] && other.m_coeffs[i] && m_coeffs[i] != other.m_coeffs[i]) memcpy(m_coeffs[i], other.m_coeffs[i], sizeof(TCoeff) * area);
+    // the coefficients are only ever read behind a set cbf, there is nothing to promote for a block without any
+    if (other.cbf[i] && m_coeffs[i] && other.m_coeffs[i] && m_coeffs[i] != other.m_coeffs[i]) memcpy(m_coeffs[i], other.m_coeffs[i], sizeof(TCoeff) * area);
     if (m_pcmbuf[i] && other.m_pcmbuf[i] && m_pcmbuf[i] != other.m_pcmbuf[i]) memcpy(m_pcmbuf[i], other.m_pcmbuf[i], sizeof(Pel   ) * area);
 
     cbf[i]           = other.cbf[i];
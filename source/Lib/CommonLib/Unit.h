@@ -363,8 +363,7 @@ struct InterPredictionData
   MergeType mergeType;
 #if JVET_K_AFFINE
   Mv        mvdAffi [NUM_REF_PIC_LIST_01][4];
-
-  double perspParam[2];
+  Mv        mvAffi  [NUM_REF_PIC_LIST_01][4]; ///< control point MVs (LT, RT, LB, RB), mirrors the motion buffer corners
 #endif
 };
 
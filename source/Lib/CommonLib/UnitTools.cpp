@@ -1118,7 +1118,7 @@ bool PU::getColocatedMVP(const PredictionUnit &pu, const RefPicList &eRefPicList
 
   RefPicList eColRefPicList = slice.getCheckLDC() ? eRefPicList : RefPicList(slice.getColFromL0Flag());
 
-  const MotionInfo& mi = pColPic->cs->getMotionInfo( pos );
+  const MotionInfo& mi = pu.cs->pcv->noMotComp ? pColPic->cs->getMotionInfo( pos ) : pColPic->cs->getColMotionInfo( pos );
 
   if( !mi.isInter )
   {
@@ -1486,15 +1486,10 @@ void PU::xInheritedAffineMv( const PredictionUnit &pu, const PredictionUnit* puN
   int curH = pu.Y().height;
 #endif
   
-  Mv mvLT, mvRT, mvLB, mvRB;
-  const Position posLT = puNeighbour->Y().topLeft();
-  const Position posRT = puNeighbour->Y().topRight();
-  const Position posLB = puNeighbour->Y().bottomLeft();
-  const Position posRB = puNeighbour->Y().bottomRight();
-  mvLT = puNeighbour->getMotionInfo( posLT ).mv[eRefPicList];
-  mvRT = puNeighbour->getMotionInfo( posRT ).mv[eRefPicList];
-  mvLB = puNeighbour->getMotionInfo( posLB ).mv[eRefPicList];
-  mvRB = puNeighbour->getMotionInfo( posRB ).mv[eRefPicList];
+  Mv mvLT = puNeighbour->mvAffi[eRefPicList][0];
+  Mv mvRT = puNeighbour->mvAffi[eRefPicList][1];
+  Mv mvLB = puNeighbour->mvAffi[eRefPicList][2];
+  Mv mvRB = puNeighbour->mvAffi[eRefPicList][3];
 
 #if JVET_K_AFFINE_BUG_FIXES
   int shift = MAX_CU_DEPTH;
@@ -2382,7 +2377,7 @@ void PU::setAllAffineMvField( PredictionUnit &pu, MvField *mvField, RefPicList e
   pu.refIdx[eRefList] = mvField[0].refIdx;
 }
 
-void PU::setAllAffineMv( PredictionUnit& pu, Mv affLT, Mv affRT, Mv affLB, Mv affRB, RefPicList eRefList )
+void PU::setAllAffineMv( PredictionUnit& pu, Mv affLT, Mv affRT, Mv affLB, Mv affRB, RefPicList eRefList, const bool spanSubBlocks )
 {
   int width  = pu.Y().width;
   int shift = MAX_CU_DEPTH;
@@ -2467,11 +2462,16 @@ void PU::setAllAffineMv( PredictionUnit& pu, Mv affLT, Mv affRT, Mv affLB, Mv af
   const int halfBW = blockWidth >> 1;
   const int halfBH = blockHeight >> 1;
 
+  // without spanning only the bottom corner sub-blocks are derived, their motion ends up in the corner entries of the PU
+  const int puHeight = pu.Y().height;
+  const int wStep    = spanSubBlocks ? blockWidth : std::max( blockWidth, width - blockWidth );
+  Mv cornerMv[4];
+
   MotionBuf mb = pu.getMotionBuf();
   int mvScaleTmpHor, mvScaleTmpVer;
-  for ( int h = 0; h < pu.Y().height; h += blockHeight )
+  for ( int h = spanSubBlocks ? 0 : puHeight - blockHeight; h < puHeight; h += blockHeight )
   {
-    for ( int w = 0; w < pu.Y().width; w += blockWidth )
+    for ( int w = 0; w < width; w += wStep )
     {
       mvScaleTmpHor = mvScaleHor + deltaMvHorX * (halfBW + w) + deltaMvVerX * (halfBH + h);
       mvScaleTmpVer = mvScaleVer + deltaMvHorY * (halfBW + w) + deltaMvVerY * (halfBH + h);
@@ -2496,39 +2496,77 @@ void PU::setAllAffineMv( PredictionUnit& pu, Mv affLT, Mv affRT, Mv affLB, Mv af
       mvScaleTmpVer >>= shift;
 #endif
 
-      for ( int y = (h >> MIN_CU_LOG2); y < ((h + blockHeight) >> MIN_CU_LOG2); y++ )
+      const Mv subBlockMv( mvScaleTmpHor, mvScaleTmpVer, true );
+
+      if ( spanSubBlocks )
+      {
+        for ( int y = (h >> MIN_CU_LOG2); y < ((h + blockHeight) >> MIN_CU_LOG2); y++ )
+        {
+          for ( int x = (w >> MIN_CU_LOG2); x < ((w + blockHeight) >> MIN_CU_LOG2); x++ )
+          {
+            mb.at( x, y ).mv[eRefList] = subBlockMv;
+          }
+        }
+      }
+      if ( h + blockHeight >= puHeight )
       {
-        for ( int x = (w >> MIN_CU_LOG2); x < ((w + blockHeight) >> MIN_CU_LOG2); x++ )
+        if ( w == 0 )
+        {
+          cornerMv[2] = subBlockMv;
+        }
+        if ( w + blockWidth >= width )
         {
-          mb.at( x, y ).mv[eRefList] = Mv( mvScaleTmpHor, mvScaleTmpVer, true );
+          cornerMv[3] = subBlockMv;
         }
       }
     }
   }
 
   // Set AffineMvField for affine motion compensation LT, RT, LB and RB
+  cornerMv[0] = affLT;
+  cornerMv[1] = affRT;
 #if !JVET_K_AFFINE_BUG_FIXES
-  Mv mv = affRT + affLB - affLT;
-#endif
-  mb.at(            0,             0 ).mv[eRefList] = affLT;
-  mb.at( mb.width - 1,             0 ).mv[eRefList] = affRT;
-#if !JVET_K_AFFINE_BUG_FIXES
-  mb.at(            0, mb.height - 1 ).mv[eRefList] = affLB;
-  mb.at( mb.width - 1, mb.height - 1 ).mv[eRefList] = mv;
+  cornerMv[2] = affLB;
+  cornerMv[3] = affRT + affLB - affLT;
 #endif
 
 #if JVET_K0337_AFFINE_6PARA
   if ( pu.cu->affineType == AFFINEMODEL_6PARAM || pu.cu->affineType == AFFINEMODEL_8PARAM )
   {
-    mb.at( 0, mb.height - 1 ).mv[eRefList] = affLB;
+    cornerMv[2] = affLB;
   }
 #endif
 #if JVET_YJC_PERSP_8PARA
   if (pu.cu->affineType == AFFINEMODEL_8PARAM)
   {
-	mb.at( mb.width - 1, mb.height - 1 ).mv[eRefList] = affRB;
+    cornerMv[3] = affRB;
   }
 #endif
+
+  // keep the control point MVs with the PU, so that neighbours and the encoder need not read them back from the motion buffer
+  for ( int i = 0; i < 4; i++ )
+  {
+    pu.mvAffi[eRefList][i] = cornerMv[i];
+  }
+
+  if ( spanSubBlocks )
+  {
+    mb.at(            0,             0 ).mv[eRefList] = cornerMv[0];
+    mb.at( mb.width - 1,             0 ).mv[eRefList] = cornerMv[1];
+    mb.at(            0, mb.height - 1 ).mv[eRefList] = cornerMv[2];
+    mb.at( mb.width - 1, mb.height - 1 ).mv[eRefList] = cornerMv[3];
+  }
+}
+
+void PU::spanAffineMv( PredictionUnit& pu )
+{
+  for ( int i = 0; i < NUM_REF_PIC_LIST_01; i++ )
+  {
+    if ( pu.refIdx[i] >= 0 )
+    {
+      setAllAffineMv( pu, pu.mvAffi[i][0], pu.mvAffi[i][1], pu.mvAffi[i][2], pu.mvAffi[i][3], RefPicList( i ) );
+    }
+  }
 }
 #endif
 
@@ -2540,7 +2578,12 @@ static bool deriveScaledMotionTemporal( const Slice&      slice,
                                         Mv&         cColMv,
                                         const RefPicList  eFetchRefPicList)
 {
+#if JVET_K0346
+  // the callers mask colPos to the motion compression grid, so the compressed store can be used
+  const MotionInfo &mi = pColPic->cs->getColMotionInfo(colPos);
+#else
   const MotionInfo &mi = pColPic->cs->getMotionInfo(colPos);
+#endif
   const Slice *pColSlice = nullptr;
 
   for (const auto &pSlice : pColPic->slices)
@@ -2752,7 +2795,7 @@ bool PU::getInterMergeSubPuMvpCand(const PredictionUnit &pu, MergeCtx& mrgCtx, b
   centerPos = Position{ PosType(centerPos.x & mask), PosType(centerPos.y & mask) };
 
   // derivation of center motion parameters from the collocated CU
-  const MotionInfo &mi = pColPic->cs->getMotionInfo(centerPos);
+  const MotionInfo &mi = pColPic->cs->getColMotionInfo(centerPos);
 
   if (mi.isInter)
   {
@@ -2896,7 +2939,11 @@ bool PU::getInterMergeSubPuMvpCand(const PredictionUnit &pu, MergeCtx& mrgCtx, b
       colPos = Position{ PosType(colPos.x & mask), PosType(colPos.y & mask) };
 #endif
 
+#if JVET_K0346
+      const MotionInfo &colMi = pColPic->cs->getColMotionInfo(colPos);
+#else
       const MotionInfo &colMi = pColPic->cs->getMotionInfo(colPos);
+#endif
 
       MotionInfo mi;
 
@@ -2981,6 +3028,16 @@ void PU::spanMotionInfo( PredictionUnit &pu, const MergeCtx &mrgCtx )
 #if JVET_K_AFFINE
     if( pu.cu->affine )
     {
+      for( int i = 0; i < NUM_REF_PIC_LIST_01; i++ )
+      {
+        if( mi.refIdx[i] == -1 )
+        {
+          for( int j = 0; j < 4; j++ )
+          {
+            pu.mvAffi[i][j] = Mv();
+          }
+        }
+      }
       for( int y = 0; y < mb.height; y++ )
       {
         for( int x = 0; x < mb.width; x++ )
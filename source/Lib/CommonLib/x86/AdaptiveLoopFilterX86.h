@@ -66,9 +66,99 @@ static void simdDeriveClassificationBlk( AlfClassifier** classifier, int** lapla
   const int posY = blk.pos().y;
   const int start_height1 = posY - flplusOne;
 
-  static uint16_t _temp[( AdaptiveLoopFilter::m_CLASSIFICATION_BLK_SIZE + 4 ) >> 1][AdaptiveLoopFilter::m_CLASSIFICATION_BLK_SIZE + 4];
+  uint16_t _temp[( AdaptiveLoopFilter::m_CLASSIFICATION_BLK_SIZE + 4 ) >> 1][AdaptiveLoopFilter::m_CLASSIFICATION_BLK_SIZE + 4];
 
-  for( int i = 0; i < imgHExtended - 2; i += 2 )
+  int i = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    // two row pairs at once: the lower lane holds rows i, the upper lane rows i + 2,
+    // all shuffles below operate within 128-bit lanes, so each lane mirrors the SSE path
+    for( ; i < imgHExtended - 4; i += 4 )
+    {
+      int yoffset = ( i + 1 + start_height1 ) * img_stride - flplusOne;
+
+      const Pel *p_imgY_pad_down = &srcExt[yoffset - img_stride];
+      const Pel *p_imgY_pad = &srcExt[yoffset];
+      const Pel *p_imgY_pad_up = &srcExt[yoffset + img_stride];
+      const Pel *p_imgY_pad_up2 = &srcExt[yoffset + img_stride * 2];
+      const Pel *p_imgY_pad_up3 = &srcExt[yoffset + img_stride * 3];
+      const Pel *p_imgY_pad_up4 = &srcExt[yoffset + img_stride * 4];
+
+      __m256i mmStore = _mm256_setzero_si256();
+
+      for( int j = 2; j < imgWExtended; j += 8 )
+      {
+        const int pixY = j - 1 + posX;
+
+        __m256i ymm0 = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( ( __m128i* )( p_imgY_pad_down + pixY - 1 ) ) ), _mm_loadu_si128( ( __m128i* )( p_imgY_pad_up + pixY - 1 ) ), 1 );
+        __m256i ymm1 = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( ( __m128i* )( p_imgY_pad + pixY - 1 ) ) ), _mm_loadu_si128( ( __m128i* )( p_imgY_pad_up2 + pixY - 1 ) ), 1 );
+        __m256i ymm2 = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( ( __m128i* )( p_imgY_pad_up + pixY - 1 ) ) ), _mm_loadu_si128( ( __m128i* )( p_imgY_pad_up3 + pixY - 1 ) ), 1 );
+        __m256i ymm3 = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( ( __m128i* )( p_imgY_pad_up2 + pixY - 1 ) ) ), _mm_loadu_si128( ( __m128i* )( p_imgY_pad_up4 + pixY - 1 ) ), 1 );
+
+        const __m256i ymm0_next = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( ( __m128i* )( p_imgY_pad_down + pixY + 7 ) ) ), _mm_loadu_si128( ( __m128i* )( p_imgY_pad_up + pixY + 7 ) ), 1 );
+        const __m256i ymm1_next = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( ( __m128i* )( p_imgY_pad + pixY + 7 ) ) ), _mm_loadu_si128( ( __m128i* )( p_imgY_pad_up2 + pixY + 7 ) ), 1 );
+        const __m256i ymm2_next = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( ( __m128i* )( p_imgY_pad_up + pixY + 7 ) ) ), _mm_loadu_si128( ( __m128i* )( p_imgY_pad_up3 + pixY + 7 ) ), 1 );
+        const __m256i ymm3_next = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( ( __m128i* )( p_imgY_pad_up2 + pixY + 7 ) ) ), _mm_loadu_si128( ( __m128i* )( p_imgY_pad_up4 + pixY + 7 ) ), 1 );
+
+        __m256i ymm4 = _mm256_slli_epi16( _mm256_alignr_epi8( ymm1_next, ymm1, 2 ), 1 );
+        __m256i ymm5 = _mm256_slli_epi16( _mm256_alignr_epi8( ymm2_next, ymm2, 2 ), 1 );
+
+        //dig0
+        __m256i ymm6 = _mm256_sub_epi16( ymm4, _mm256_add_epi16( _mm256_alignr_epi8( ymm2_next, ymm2, 4 ), ymm0 ) );
+        __m256i ymm8 = _mm256_sub_epi16( ymm5, _mm256_add_epi16( _mm256_alignr_epi8( ymm3_next, ymm3, 4 ), ymm1 ) );
+
+        //dig1
+        __m256i ymm9 = _mm256_sub_epi16( ymm4, _mm256_add_epi16( _mm256_alignr_epi8( ymm0_next, ymm0, 4 ), ymm2 ) );
+        __m256i ymm10 = _mm256_sub_epi16( ymm5, _mm256_add_epi16( _mm256_alignr_epi8( ymm1_next, ymm1, 4 ), ymm3 ) );
+
+        //hor
+        __m256i ymm13 = _mm256_sub_epi16( ymm4, _mm256_add_epi16( _mm256_alignr_epi8( ymm1_next, ymm1, 4 ), ymm1 ) );
+        __m256i ymm14 = _mm256_sub_epi16( ymm5, _mm256_add_epi16( _mm256_alignr_epi8( ymm2_next, ymm2, 4 ), ymm2 ) );
+
+        //ver
+        __m256i ymm11 = _mm256_sub_epi16( ymm4, _mm256_add_epi16( _mm256_alignr_epi8( ymm0_next, ymm0, 2 ), _mm256_alignr_epi8( ymm2_next, ymm2, 2 ) ) );
+        __m256i ymm12 = _mm256_sub_epi16( ymm5, _mm256_add_epi16( _mm256_alignr_epi8( ymm1_next, ymm1, 2 ), _mm256_alignr_epi8( ymm3_next, ymm3, 2 ) ) );
+
+        ymm6 = _mm256_add_epi16( _mm256_abs_epi16( ymm6 ), _mm256_abs_epi16( ymm8 ) );
+        ymm9 = _mm256_add_epi16( _mm256_abs_epi16( ymm9 ), _mm256_abs_epi16( ymm10 ) );
+        ymm11 = _mm256_add_epi16( _mm256_abs_epi16( ymm11 ), _mm256_abs_epi16( ymm12 ) );
+        ymm13 = _mm256_add_epi16( _mm256_abs_epi16( ymm13 ), _mm256_abs_epi16( ymm14 ) );
+
+        ymm6 = _mm256_add_epi16( ymm6, _mm256_srli_si256( ymm6, 2 ) );
+        ymm9 = _mm256_add_epi16( ymm9, _mm256_slli_si256( ymm9, 2 ) );
+        ymm11 = _mm256_add_epi16( ymm11, _mm256_srli_si256( ymm11, 2 ) );
+        ymm13 = _mm256_add_epi16( ymm13, _mm256_slli_si256( ymm13, 2 ) );
+
+        ymm6 = _mm256_blend_epi16( ymm6, ymm9, 0xAA );
+        ymm11 = _mm256_blend_epi16( ymm11, ymm13, 0xAA );
+
+        ymm6 = _mm256_add_epi16( ymm6, _mm256_slli_si256( ymm6, 4 ) );
+        ymm11 = _mm256_add_epi16( ymm11, _mm256_srli_si256( ymm11, 4 ) );
+
+        ymm6 = _mm256_blend_epi16( ymm11, ymm6, 0xCC );
+
+        ymm9 = _mm256_srli_si256( ymm6, 8 );
+
+        if( j > 2 )
+        {
+          const __m256i ymmSum = _mm256_add_epi16( ymm6, mmStore );
+          _mm_storel_epi64( ( __m128i* )( &( _temp[( i >> 1 ) + 0][j - 2 - 4] ) ), _mm256_castsi256_si128( ymmSum ) );
+          _mm_storel_epi64( ( __m128i* )( &( _temp[( i >> 1 ) + 1][j - 2 - 4] ) ), _mm256_extracti128_si256( ymmSum, 1 ) );
+        }
+
+        ymm6 = _mm256_add_epi16( ymm6, ymm9 );  //V H D0 D1
+        _mm_storel_epi64( ( __m128i* )( &( _temp[( i >> 1 ) + 0][j - 2] ) ), _mm256_castsi256_si128( ymm6 ) );
+        _mm_storel_epi64( ( __m128i* )( &( _temp[( i >> 1 ) + 1][j - 2] ) ), _mm256_extracti128_si256( ymm6, 1 ) );
+
+        mmStore = ymm9;
+      }
+    }
+  }
+#endif
+
+  for( ; i < imgHExtended - 2; i += 2 )
   {
     int yoffset = ( i + 1 + start_height1 ) * img_stride - flplusOne;
 
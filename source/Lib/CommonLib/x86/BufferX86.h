@@ -362,6 +362,70 @@ void linTf_SSE_entry( const Pel* src, int srcStride, Pel *dst, int dstStride, in
   }
 }
 
+template<X86_VEXT vext>
+void padding_SSE( Pel* ptr, int stride, int width, int height, int padW, int padH )
+{
+  Pel* p = ptr;
+
+  // left and right margins, the last store of each side overlaps the previous one
+#if USE_AVX2
+  if( vext >= AVX2 && padW >= 16 )
+  {
+    for( int y = 0; y < height; y++, p += stride )
+    {
+      const __m256i vl = _mm256_set1_epi16( p[0] );
+      const __m256i vr = _mm256_set1_epi16( p[width - 1] );
+
+      for( int x = 0; x < padW - 16; x += 16 )
+      {
+        _mm256_storeu_si256( ( __m256i* ) &p[x - padW],  vl );
+        _mm256_storeu_si256( ( __m256i* ) &p[width + x], vr );
+      }
+      _mm256_storeu_si256( ( __m256i* ) &p[-16],                vl );
+      _mm256_storeu_si256( ( __m256i* ) &p[width + padW - 16], vr );
+    }
+  }
+  else
+#endif
+  if( padW >= 8 )
+  {
+    for( int y = 0; y < height; y++, p += stride )
+    {
+      const __m128i vl = _mm_set1_epi16( p[0] );
+      const __m128i vr = _mm_set1_epi16( p[width - 1] );
+
+      for( int x = 0; x < padW - 8; x += 8 )
+      {
+        _mm_storeu_si128( ( __m128i* ) &p[x - padW],  vl );
+        _mm_storeu_si128( ( __m128i* ) &p[width + x], vr );
+      }
+      _mm_storeu_si128( ( __m128i* ) &p[-8],                vl );
+      _mm_storeu_si128( ( __m128i* ) &p[width + padW - 8], vr );
+    }
+  }
+  else
+  {
+    for( int y = 0; y < height; y++, p += stride )
+    {
+      for( int x = 1; x <= padW; x++ )
+      {
+        p[-x]            = p[0];
+        p[width + x - 1] = p[width - 1];
+      }
+    }
+  }
+
+  // top and bottom margins as copies of the first and last extended rows
+  const Pel* top    = ptr - padW;
+  const Pel* bottom = ptr - padW + ( height - 1 ) * stride;
+
+  for( int y = 1; y <= padH; y++ )
+  {
+    ::memcpy( ( Pel* ) top    - y * stride, top,    sizeof( Pel ) * ( width + 2 * padW ) );
+    ::memcpy( ( Pel* ) bottom + y * stride, bottom, sizeof( Pel ) * ( width + 2 * padW ) );
+  }
+}
+
 template<X86_VEXT vext>
 void PelBufferOps::_initPelBufOpsX86()
 {
@@ -373,6 +437,8 @@ void PelBufferOps::_initPelBufOpsX86()
 
   linTf8 = linTf_SSE_entry<vext, 8>;
   linTf4 = linTf_SSE_entry<vext, 4>;
+
+  padding = padding_SSE<vext>;
 }
 
 template void PelBufferOps::_initPelBufOpsX86<SIMDX86>();
@@ -0,0 +1,411 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     IntraPredictionX86.h
+    \brief    SIMD for intra prediction
+*/
+#include "CommonDefX86.h"
+#include "../IntraPrediction.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#if ENABLE_SIMD_OPT_INTRAPRED
+#ifdef TARGET_SIMD_X86
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+template<X86_VEXT vext>
+static void simdPredIntraAngCore( Pel* pDst, const int dstStride, const Pel* refMain, const int width, const int height, const int intraPredAngle )
+{
+  if( width < 4 )
+  {
+    IntraPrediction::predIntraAngCore( pDst, dstStride, refMain, width, height, intraPredAngle );
+    return;
+  }
+
+  const __m128i vrnd = _mm_set1_epi32( 16 );
+
+  for( int y = 0, deltaPos = intraPredAngle; y < height; y++, deltaPos += intraPredAngle, pDst += dstStride )
+  {
+    const int deltaInt   = deltaPos >> 5;
+    const int deltaFract = deltaPos & ( 32 - 1 );
+    const Pel *pRM       = refMain + deltaInt + 1;
+
+    if( !deltaFract )
+    {
+      memcpy( pDst, pRM, width * sizeof( Pel ) );
+      continue;
+    }
+
+    // interleaved ( pRM[x], pRM[x + 1] ) pairs are weighted by ( 32 - deltaFract, deltaFract )
+    const int coef = ( deltaFract << 16 ) | ( 32 - deltaFract );
+
+    if( width == 4 )
+    {
+      __m128i va = _mm_loadl_epi64( ( const __m128i* ) ( pRM     ) );
+      __m128i vb = _mm_loadl_epi64( ( const __m128i* ) ( pRM + 1 ) );
+      __m128i vl = _mm_madd_epi16( _mm_unpacklo_epi16( va, vb ), _mm_set1_epi32( coef ) );
+      vl = _mm_srai_epi32( _mm_add_epi32( vl, vrnd ), 5 );
+      _mm_storel_epi64( ( __m128i* ) pDst, _mm_packs_epi32( vl, vl ) );
+      continue;
+    }
+
+    int x = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256i vcoef256 = _mm256_set1_epi32( coef );
+      const __m256i vrnd256  = _mm256_set1_epi32( 16 );
+
+      for( ; x + 16 <= width; x += 16 )
+      {
+        __m256i va = _mm256_loadu_si256( ( const __m256i* ) ( pRM + x     ) );
+        __m256i vb = _mm256_loadu_si256( ( const __m256i* ) ( pRM + x + 1 ) );
+        // the in-lane unpacking is undone by the in-lane packing
+        __m256i vl = _mm256_madd_epi16( _mm256_unpacklo_epi16( va, vb ), vcoef256 );
+        __m256i vh = _mm256_madd_epi16( _mm256_unpackhi_epi16( va, vb ), vcoef256 );
+        vl = _mm256_srai_epi32( _mm256_add_epi32( vl, vrnd256 ), 5 );
+        vh = _mm256_srai_epi32( _mm256_add_epi32( vh, vrnd256 ), 5 );
+        _mm256_storeu_si256( ( __m256i* ) ( pDst + x ), _mm256_packs_epi32( vl, vh ) );
+      }
+    }
+#endif
+    const __m128i vcoef = _mm_set1_epi32( coef );
+
+    for( ; x < width; x += 8 )
+    {
+      __m128i va = _mm_loadu_si128( ( const __m128i* ) ( pRM + x     ) );
+      __m128i vb = _mm_loadu_si128( ( const __m128i* ) ( pRM + x + 1 ) );
+      __m128i vl = _mm_madd_epi16( _mm_unpacklo_epi16( va, vb ), vcoef );
+      __m128i vh = _mm_madd_epi16( _mm_unpackhi_epi16( va, vb ), vcoef );
+      vl = _mm_srai_epi32( _mm_add_epi32( vl, vrnd ), 5 );
+      vh = _mm_srai_epi32( _mm_add_epi32( vh, vrnd ), 5 );
+      _mm_storeu_si128( ( __m128i* ) ( pDst + x ), _mm_packs_epi32( vl, vh ) );
+    }
+  }
+}
+
+
+template<X86_VEXT vext>
+static void simdPdpcFilterDiag( Pel* pDst, const int dstStride, const Pel* refMain, const Pel* refSide, const int width, const int height, const int scale, const ClpRng& clpRng )
+{
+  if( width < 4 )
+  {
+    IntraPrediction::pdpcFilterDiag( pDst, dstStride, refMain, refSide, width, height, scale, clpRng );
+    return;
+  }
+
+  // the left weight only depends on the column, columns with zero left and top weights are left unchanged
+  int16_t wLeft[MAX_CU_SIZE];
+  int     numLeftCols = width;
+
+  for( int x = 0; x < width; x++ )
+  {
+    wLeft[x] = 16 >> std::min( 31, ( ( x << 1 ) >> scale ) );
+    if( !wLeft[x] && numLeftCols == width )
+    {
+      numLeftCols = x;
+    }
+  }
+
+  const int     step = width == 4 ? 4 : 8;
+  const __m128i vmin = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax = _mm_set1_epi16( clpRng.max );
+  const __m128i vone = _mm_set1_epi16( 1 );
+  const __m128i vrnd = _mm_set1_epi16( 32 );
+
+  for( int y = 0; y < height; y++, pDst += dstStride )
+  {
+    const int wT = 16 >> std::min( 31, ( ( y << 1 ) >> scale ) );
+    // samples with zero weights are reproduced exactly, so the vector loop may overshoot the weighted columns
+    const int numCols = wT ? width : numLeftCols;
+
+    if( !numCols )
+    {
+      break;
+    }
+
+    const __m128i vwT = _mm_set1_epi16( wT );
+    const Pel*    pL  = refSide + y + 2;
+    const Pel*    pT  = refMain + y + 2;
+
+    for( int x = 0; x < numCols; x += step )
+    {
+      __m128i vwL = step == 4 ? _mm_loadl_epi64( ( const __m128i* ) ( wLeft + x ) ) : _mm_loadu_si128( ( const __m128i* ) ( wLeft + x ) );
+      __m128i vl  = step == 4 ? _mm_loadl_epi64( ( const __m128i* ) ( pL    + x ) ) : _mm_loadu_si128( ( const __m128i* ) ( pL    + x ) );
+      __m128i vt  = step == 4 ? _mm_loadl_epi64( ( const __m128i* ) ( pT    + x ) ) : _mm_loadu_si128( ( const __m128i* ) ( pT    + x ) );
+      __m128i vp  = step == 4 ? _mm_loadl_epi64( ( const __m128i* ) ( pDst  + x ) ) : _mm_loadu_si128( ( const __m128i* ) ( pDst  + x ) );
+      __m128i vwP = _mm_sub_epi16( _mm_sub_epi16( _mm_set1_epi16( 64 ), vwL ), vwT );
+
+      __m128i vlo = _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( vl, vt ), _mm_unpacklo_epi16( vwL, vwT ) ),
+                                   _mm_madd_epi16( _mm_unpacklo_epi16( vp, vone ), _mm_unpacklo_epi16( vwP, vrnd ) ) );
+      __m128i vhi = _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( vl, vt ), _mm_unpackhi_epi16( vwL, vwT ) ),
+                                   _mm_madd_epi16( _mm_unpackhi_epi16( vp, vone ), _mm_unpackhi_epi16( vwP, vrnd ) ) );
+
+      __m128i vres = _mm_packs_epi32( _mm_srai_epi32( vlo, 6 ), _mm_srai_epi32( vhi, 6 ) );
+      vres = _mm_min_epi16( vmax, _mm_max_epi16( vmin, vres ) );
+
+      if( step == 4 )
+      {
+        _mm_storel_epi64( ( __m128i* ) ( pDst + x ), vres );
+      }
+      else
+      {
+        _mm_storeu_si128( ( __m128i* ) ( pDst + x ), vres );
+      }
+    }
+  }
+}
+
+template<X86_VEXT vext>
+static void simdPdpcFilterNonAng( Pel* pDst, const int dstStride, const Pel* pSrc, const int srcStride, const int width, const int height, const int scale, const uint32_t dirMode, const ClpRng& clpRng )
+{
+  if( width < 4 )
+  {
+    IntraPrediction::pdpcFilterNonAng( pDst, dstStride, pSrc, srcStride, width, height, scale, dirMode, clpRng );
+    return;
+  }
+
+  // all four modes are evaluated as ( wL * left + wT * top - wTL * topLeft + ( 64 - wL - wT + wTL ) * pred + 32 ) >> 6
+  const bool useLeft = dirMode != HOR_IDX;
+  const bool useTop  = dirMode != VER_IDX;
+
+  int16_t wLeft[MAX_CU_SIZE];
+
+  for( int x = 0; x < width; x++ )
+  {
+    wLeft[x] = useLeft ? 32 >> std::min( 31, ( ( x << 1 ) >> scale ) ) : 0;
+  }
+
+  const int     step    = width == 4 ? 4 : 8;
+  const __m128i vmin    = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax    = _mm_set1_epi16( clpRng.max );
+  const __m128i v64     = _mm_set1_epi16( 64 );
+  const __m128i vrnd    = _mm_set1_epi32( 32 );
+  const __m128i vtopLft = _mm_set1_epi16( pSrc[0] );
+
+  for( int y = 0; y < height; y++, pDst += dstStride )
+  {
+    const int     wT    = useTop ? 32 >> std::min( 31, ( ( y << 1 ) >> scale ) ) : 0;
+    const __m128i vwT   = _mm_set1_epi16( wT );
+    const __m128i vleft = _mm_set1_epi16( pSrc[( y + 1 ) * srcStride] );
+
+    for( int x = 0; x < width; x += step )
+    {
+      __m128i vwL = step == 4 ? _mm_loadl_epi64( ( const __m128i* ) ( wLeft    + x ) ) : _mm_loadu_si128( ( const __m128i* ) ( wLeft    + x ) );
+      __m128i vt  = step == 4 ? _mm_loadl_epi64( ( const __m128i* ) ( pSrc + 1 + x ) ) : _mm_loadu_si128( ( const __m128i* ) ( pSrc + 1 + x ) );
+      __m128i vp  = step == 4 ? _mm_loadl_epi64( ( const __m128i* ) ( pDst     + x ) ) : _mm_loadu_si128( ( const __m128i* ) ( pDst     + x ) );
+      __m128i vwTL;
+
+      switch( dirMode )
+      {
+      case DC_IDX:  vwTL = _mm_add_epi16( _mm_srai_epi16( vwL, 4 ), _mm_set1_epi16( wT >> 4 ) ); break;
+      case HOR_IDX: vwTL = vwT;                                                                    break;
+      case VER_IDX: vwTL = vwL;                                                                    break;
+      default:      vwTL = _mm_setzero_si128();                                                    break;
+      }
+
+      __m128i vwP    = _mm_add_epi16( _mm_sub_epi16( _mm_sub_epi16( v64, vwL ), vwT ), vwTL );
+      __m128i vnwTL  = _mm_sub_epi16( _mm_setzero_si128(), vwTL );
+
+      __m128i vlo = _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( vleft, vt ), _mm_unpacklo_epi16( vwL, vwT ) ),
+                                   _mm_madd_epi16( _mm_unpacklo_epi16( vp, vtopLft ), _mm_unpacklo_epi16( vwP, vnwTL ) ) );
+      __m128i vhi = _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( vleft, vt ), _mm_unpackhi_epi16( vwL, vwT ) ),
+                                   _mm_madd_epi16( _mm_unpackhi_epi16( vp, vtopLft ), _mm_unpackhi_epi16( vwP, vnwTL ) ) );
+
+      vlo = _mm_srai_epi32( _mm_add_epi32( vlo, vrnd ), 6 );
+      vhi = _mm_srai_epi32( _mm_add_epi32( vhi, vrnd ), 6 );
+
+      __m128i vres = _mm_min_epi16( vmax, _mm_max_epi16( vmin, _mm_packs_epi32( vlo, vhi ) ) );
+
+      if( step == 4 )
+      {
+        _mm_storel_epi64( ( __m128i* ) ( pDst + x ), vres );
+      }
+      else
+      {
+        _mm_storeu_si128( ( __m128i* ) ( pDst + x ), vres );
+      }
+    }
+  }
+}
+
+template<X86_VEXT vext>
+static void simdFilterRefSamplesRow( const Pel* pSrc, Pel* pDst, const int length )
+{
+  // without high bit depth support the sum of the taps fits into 16 bit unsigned
+  const __m128i vrnd = _mm_set1_epi16( 2 );
+  int i = 0;
+
+  for( ; i + 8 <= length; i += 8 )
+  {
+    __m128i vl = _mm_loadu_si128( ( const __m128i* ) ( pSrc + i - 1 ) );
+    __m128i vc = _mm_loadu_si128( ( const __m128i* ) ( pSrc + i     ) );
+    __m128i vr = _mm_loadu_si128( ( const __m128i* ) ( pSrc + i + 1 ) );
+    __m128i vs = _mm_add_epi16( _mm_add_epi16( vl, vr ), _mm_add_epi16( _mm_slli_epi16( vc, 1 ), vrnd ) );
+    _mm_storeu_si128( ( __m128i* ) ( pDst + i ), _mm_srli_epi16( vs, 2 ) );
+  }
+
+  for( ; i < length; i++ )
+  {
+    pDst[i] = ( pSrc[i + 1] + 2 * pSrc[i] + pSrc[i - 1] + 2 ) >> 2;
+  }
+}
+
+template<X86_VEXT vext>
+static void simdTransposeBlk( const Pel* pSrc, const int srcStride, Pel* pDst, const int dstStride, const int width, const int height )
+{
+  if( ( width & 3 ) || ( height & 3 ) )
+  {
+    IntraPrediction::transposeBlk( pSrc, srcStride, pDst, dstStride, width, height );
+    return;
+  }
+
+  if( !( width & 7 ) && !( height & 7 ) )
+  {
+    for( int y = 0; y < height; y += 8 )
+    {
+      for( int x = 0; x < width; x += 8 )
+      {
+        const Pel* src = pSrc + y * srcStride + x;
+        __m128i r[8], t[8], u[8];
+
+        for( int k = 0; k < 8; k++ )
+        {
+          r[k] = _mm_loadu_si128( ( const __m128i* ) ( src + k * srcStride ) );
+        }
+        for( int k = 0; k < 8; k += 2 )
+        {
+          t[k]     = _mm_unpacklo_epi16( r[k], r[k + 1] );
+          t[k + 1] = _mm_unpackhi_epi16( r[k], r[k + 1] );
+        }
+        for( int k = 0; k < 8; k += 4 )
+        {
+          u[k]     = _mm_unpacklo_epi32( t[k],     t[k + 2] );
+          u[k + 1] = _mm_unpackhi_epi32( t[k],     t[k + 2] );
+          u[k + 2] = _mm_unpacklo_epi32( t[k + 1], t[k + 3] );
+          u[k + 3] = _mm_unpackhi_epi32( t[k + 1], t[k + 3] );
+        }
+
+        Pel* dst = pDst + x * dstStride + y;
+
+        for( int k = 0; k < 4; k++ )
+        {
+          _mm_storeu_si128( ( __m128i* ) ( dst + ( 2 * k     ) * dstStride ), _mm_unpacklo_epi64( u[k], u[k + 4] ) );
+          _mm_storeu_si128( ( __m128i* ) ( dst + ( 2 * k + 1 ) * dstStride ), _mm_unpackhi_epi64( u[k], u[k + 4] ) );
+        }
+      }
+    }
+    return;
+  }
+
+  for( int y = 0; y < height; y += 4 )
+  {
+    for( int x = 0; x < width; x += 4 )
+    {
+      const Pel* src = pSrc + y * srcStride + x;
+
+      __m128i r0 = _mm_loadl_epi64( ( const __m128i* ) ( src                 ) );
+      __m128i r1 = _mm_loadl_epi64( ( const __m128i* ) ( src +     srcStride ) );
+      __m128i r2 = _mm_loadl_epi64( ( const __m128i* ) ( src + 2 * srcStride ) );
+      __m128i r3 = _mm_loadl_epi64( ( const __m128i* ) ( src + 3 * srcStride ) );
+
+      __m128i t0 = _mm_unpacklo_epi16( r0, r1 );
+      __m128i t1 = _mm_unpacklo_epi16( r2, r3 );
+      __m128i u0 = _mm_unpacklo_epi32( t0, t1 );
+      __m128i u1 = _mm_unpackhi_epi32( t0, t1 );
+
+      Pel* dst = pDst + x * dstStride + y;
+
+      _mm_storel_epi64( ( __m128i* ) ( dst                 ), u0 );
+      _mm_storel_epi64( ( __m128i* ) ( dst +     dstStride ), _mm_unpackhi_epi64( u0, u0 ) );
+      _mm_storel_epi64( ( __m128i* ) ( dst + 2 * dstStride ), u1 );
+      _mm_storel_epi64( ( __m128i* ) ( dst + 3 * dstStride ), _mm_unpackhi_epi64( u1, u1 ) );
+    }
+  }
+}
+
+template<X86_VEXT vext>
+static void simdDownsampleLumaRec( const Pel* pRecSrc, const int recStride, Pel* pDst, const int dstStride, const int width, const int height )
+{
+  // madd on ( s[2i], s[2i+1] ) gives 2 * s[2i] + s[2i+1], madd on ( s[2i-1], s[2i] ) gives s[2i-1]
+  const __m128i vc21 = _mm_set1_epi32( ( 1 << 16 ) | 2 );
+  const __m128i vc10 = _mm_set1_epi32( 1 );
+  const __m128i vrnd = _mm_set1_epi32( 4 );
+
+  for( int j = 0; j < height; j++, pRecSrc += 2 * recStride, pDst += dstStride )
+  {
+    const Pel* s0 = pRecSrc;
+    const Pel* s1 = pRecSrc + recStride;
+    int i = 0;
+
+    for( ; i + 4 <= width; i += 4 )
+    {
+      __m128i vsum = _mm_add_epi32( _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) ( s0 + 2 * i     ) ), vc21 ),
+                                    _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) ( s0 + 2 * i - 1 ) ), vc10 ) );
+      vsum = _mm_add_epi32( vsum, _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) ( s1 + 2 * i     ) ), vc21 ) );
+      vsum = _mm_add_epi32( vsum, _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) ( s1 + 2 * i - 1 ) ), vc10 ) );
+      vsum = _mm_srai_epi32( _mm_add_epi32( vsum, vrnd ), 3 );
+      _mm_storel_epi64( ( __m128i* ) ( pDst + i ), _mm_packs_epi32( vsum, vsum ) );
+    }
+
+    for( ; i < width; i++ )
+    {
+      pDst[i] = ( s0[2 * i] * 2 + s0[2 * i + 1] + s0[2 * i - 1]
+                + s1[2 * i] * 2 + s1[2 * i + 1] + s1[2 * i - 1]
+                + 4 ) >> 3;
+    }
+  }
+}
+
+template <X86_VEXT vext>
+void IntraPrediction::_initIntraPredictionX86()
+{
+  m_predAngCore       = simdPredIntraAngCore<vext>;
+  m_pdpcFilterDiag    = simdPdpcFilterDiag<vext>;
+  m_pdpcFilterNonAng  = simdPdpcFilterNonAng<vext>;
+  m_filterRefRow      = simdFilterRefSamplesRow<vext>;
+  m_transposeBlk      = simdTransposeBlk<vext>;
+  m_downsampleLumaRec = simdDownsampleLumaRec<vext>;
+}
+
+template void IntraPrediction::_initIntraPredictionX86<SIMDX86>();
+
+#endif //#ifdef TARGET_SIMD_X86
+#endif //#if ENABLE_SIMD_OPT_INTRAPRED
+//! \}
@@ -0,0 +1,515 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     LoopFilterX86.h
+    \brief    deblocking filter class
+*/
+#include "CommonDefX86.h"
+#include "../LoopFilter.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#if ENABLE_SIMD_OPT_DBLF
+#ifdef TARGET_SIMD_X86
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+// The filters work on one line per 16-bit lane. All intermediate values of the luma decisions and filters
+// fit into 16 bit for bit depths up to 10, higher bit depths are handled by the scalar implementation.
+#define DBLF_SIMD_MAX_BIT_DEPTH   10
+#define DBLF_LINES_PER_SEG        ( DEBLOCK_SMALLEST_BLOCK / 2 )
+
+// broadcasts lines 0 and 3 of each 4-line segment to all lines of the segment
+#define DBLF_BC_LINE0(x)          _mm_shufflehi_epi16( _mm_shufflelo_epi16( x, 0x00 ), 0x00 )
+#define DBLF_BC_LINE3(x)          _mm_shufflehi_epi16( _mm_shufflelo_epi16( x, 0xff ), 0xff )
+
+static inline __m128i simdSegsToLanes( const int a, const int b )
+{
+  return _mm_unpacklo_epi64( _mm_set1_epi16( a ), _mm_set1_epi16( b ) );
+}
+
+/**
+ - Decision and filtering of two 4-line luma segments, m[0..7] holds the samples p3..q3 with one line per lane
+ */
+static inline void simdFilterLuma8Lines( __m128i* m, const LFSegParam* segs, const ClpRng& clpRng )
+{
+  const __m128i vzero   = _mm_setzero_si128();
+  const __m128i vone    = _mm_set1_epi16( 1 );
+  const __m128i vtwo    = _mm_set1_epi16( 2 );
+  const __m128i vfour   = _mm_set1_epi16( 4 );
+  const __m128i vmin    = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax    = _mm_set1_epi16( clpRng.max );
+
+  const __m128i vtc     = simdSegsToLanes( segs[0].tc,   segs[1].tc );
+  const __m128i vbeta   = simdSegsToLanes( segs[0].beta, segs[1].beta );
+  const __m128i vnoP    = simdSegsToLanes( segs[0].partPNoFilter ? -1 : 0, segs[1].partPNoFilter ? -1 : 0 );
+  const __m128i vnoQ    = simdSegsToLanes( segs[0].partQNoFilter ? -1 : 0, segs[1].partQNoFilter ? -1 : 0 );
+
+  // decisions
+  const __m128i vdp     = _mm_abs_epi16( _mm_add_epi16( _mm_sub_epi16( m[1], _mm_slli_epi16( m[2], 1 ) ), m[3] ) );
+  const __m128i vdq     = _mm_abs_epi16( _mm_add_epi16( _mm_sub_epi16( m[4], _mm_slli_epi16( m[5], 1 ) ), m[6] ) );
+  const __m128i vdl     = _mm_add_epi16( vdp, vdq );
+
+  const __m128i vdSeg   = _mm_add_epi16( DBLF_BC_LINE0( vdl ), DBLF_BC_LINE3( vdl ) );
+  const __m128i vdpSeg  = _mm_add_epi16( DBLF_BC_LINE0( vdp ), DBLF_BC_LINE3( vdp ) );
+  const __m128i vdqSeg  = _mm_add_epi16( DBLF_BC_LINE0( vdq ), DBLF_BC_LINE3( vdq ) );
+
+  const __m128i vside   = _mm_srai_epi16( _mm_add_epi16( vbeta, _mm_srai_epi16( vbeta, 1 ) ), 3 );
+  const __m128i vfilt   = _mm_cmplt_epi16( vdSeg,  vbeta );
+  const __m128i vfiltP  = _mm_cmplt_epi16( vdpSeg, vside );
+  const __m128i vfiltQ  = _mm_cmplt_epi16( vdqSeg, vside );
+
+  const __m128i vdStr   = _mm_add_epi16( _mm_abs_epi16( _mm_sub_epi16( m[0], m[3] ) ), _mm_abs_epi16( _mm_sub_epi16( m[7], m[4] ) ) );
+  const __m128i vtc5    = _mm_srai_epi16( _mm_add_epi16( _mm_mullo_epi16( vtc, _mm_set1_epi16( 5 ) ), vone ), 1 );
+  __m128i       vswl    = _mm_cmplt_epi16( vdStr, _mm_srai_epi16( vbeta, 3 ) );
+  vswl                  = _mm_and_si128( vswl, _mm_cmplt_epi16( _mm_slli_epi16( vdl, 1 ), _mm_srai_epi16( vbeta, 2 ) ) );
+  vswl                  = _mm_and_si128( vswl, _mm_cmplt_epi16( _mm_abs_epi16( _mm_sub_epi16( m[3], m[4] ) ), vtc5 ) );
+  const __m128i vsw     = _mm_and_si128( DBLF_BC_LINE0( vswl ), DBLF_BC_LINE3( vswl ) );
+
+  // strong filter
+  const __m128i vtc2    = _mm_slli_epi16( vtc, 1 );
+  const __m128i vsum34  = _mm_add_epi16( m[3], m[4] );
+  __m128i       vs[6];
+  vs[0] = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( _mm_add_epi16( _mm_slli_epi16( _mm_add_epi16( m[2], vsum34 ), 1 ), m[1] ), m[5] ), vfour ), 3 );                 // p0
+  vs[1] = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( _mm_add_epi16( _mm_slli_epi16( _mm_add_epi16( m[5], vsum34 ), 1 ), m[2] ), m[6] ), vfour ), 3 );                 // q0
+  vs[2] = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( _mm_add_epi16( m[1], m[2] ), vsum34 ), vtwo ), 2 );                                                             // p1
+  vs[3] = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( _mm_add_epi16( m[5], m[6] ), vsum34 ), vtwo ), 2 );                                                             // q1
+  vs[4] = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( _mm_add_epi16( _mm_slli_epi16( m[0], 1 ), _mm_mullo_epi16( m[1], _mm_set1_epi16( 3 ) ) ), _mm_add_epi16( m[2], vsum34 ) ), vfour ), 3 );  // p2
+  vs[5] = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( _mm_add_epi16( _mm_slli_epi16( m[7], 1 ), _mm_mullo_epi16( m[6], _mm_set1_epi16( 3 ) ) ), _mm_add_epi16( m[5], vsum34 ) ), vfour ), 3 );  // q2
+
+  static const int strongPos[6] = { 3, 4, 2, 5, 1, 6 };
+  for( int i = 0; i < 6; i++ )
+  {
+    const __m128i vorg = m[strongPos[i]];
+    vs[i] = _mm_min_epi16( _mm_max_epi16( vs[i], _mm_sub_epi16( vorg, vtc2 ) ), _mm_add_epi16( vorg, vtc2 ) );
+  }
+
+  // weak filter
+  __m128i vdelta        = _mm_sub_epi16( _mm_mullo_epi16( _mm_sub_epi16( m[4], m[3] ), _mm_set1_epi16( 9 ) ), _mm_mullo_epi16( _mm_sub_epi16( m[5], m[2] ), _mm_set1_epi16( 3 ) ) );
+  vdelta                = _mm_srai_epi16( _mm_add_epi16( vdelta, _mm_set1_epi16( 8 ) ), 4 );
+  const __m128i vweak   = _mm_cmplt_epi16( _mm_abs_epi16( vdelta ), _mm_mullo_epi16( vtc, _mm_set1_epi16( 10 ) ) );
+  vdelta                = _mm_min_epi16( _mm_max_epi16( vdelta, _mm_sub_epi16( vzero, vtc ) ), vtc );
+
+  const __m128i vtcH    = _mm_srai_epi16( vtc, 1 );
+  const __m128i vtcHNeg = _mm_sub_epi16( vzero, vtcH );
+  __m128i vdelta1       = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( m[1], m[3] ), vone ), 1 );
+  vdelta1               = _mm_srai_epi16( _mm_add_epi16( _mm_sub_epi16( vdelta1, m[2] ), vdelta ), 1 );
+  vdelta1               = _mm_min_epi16( _mm_max_epi16( vdelta1, vtcHNeg ), vtcH );
+  __m128i vdelta2       = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( m[6], m[4] ), vone ), 1 );
+  vdelta2               = _mm_srai_epi16( _mm_sub_epi16( _mm_sub_epi16( vdelta2, m[5] ), vdelta ), 1 );
+  vdelta2               = _mm_min_epi16( _mm_max_epi16( vdelta2, vtcHNeg ), vtcH );
+
+  const __m128i vw3     = _mm_min_epi16( _mm_max_epi16( _mm_add_epi16( m[3], vdelta  ), vmin ), vmax );
+  const __m128i vw4     = _mm_min_epi16( _mm_max_epi16( _mm_sub_epi16( m[4], vdelta  ), vmin ), vmax );
+  const __m128i vw2     = _mm_min_epi16( _mm_max_epi16( _mm_add_epi16( m[2], vdelta1 ), vmin ), vmax );
+  const __m128i vw5     = _mm_min_epi16( _mm_max_epi16( _mm_add_epi16( m[5], vdelta2 ), vmin ), vmax );
+
+  // selection
+  const __m128i vselS   = _mm_and_si128( vfilt, vsw );
+  const __m128i vselW   = _mm_andnot_si128( vsw, _mm_and_si128( vfilt, vweak ) );
+  const __m128i vselSP  = _mm_andnot_si128( vnoP, vselS );
+  const __m128i vselSQ  = _mm_andnot_si128( vnoQ, vselS );
+  const __m128i vselWP  = _mm_andnot_si128( vnoP, vselW );
+  const __m128i vselWQ  = _mm_andnot_si128( vnoQ, vselW );
+
+  m[1] = _mm_blendv_epi8( m[1], vs[4], vselSP );
+  m[2] = _mm_blendv_epi8( _mm_blendv_epi8( m[2], vw2, _mm_and_si128( vselWP, vfiltP ) ), vs[2], vselSP );
+  m[3] = _mm_blendv_epi8( _mm_blendv_epi8( m[3], vw3, vselWP ), vs[0], vselSP );
+  m[4] = _mm_blendv_epi8( _mm_blendv_epi8( m[4], vw4, vselWQ ), vs[1], vselSQ );
+  m[5] = _mm_blendv_epi8( _mm_blendv_epi8( m[5], vw5, _mm_and_si128( vselWQ, vfiltQ ) ), vs[3], vselSQ );
+  m[6] = _mm_blendv_epi8( m[6], vs[5], vselSQ );
+}
+
+#ifdef USE_AVX2
+// transposes two 8x8 blocks of 16-bit samples, one in each 128-bit half
+#define DBLF_TRANSPOSE8x8_AVX2(T) \
+{\
+  __m256i a03b03 = _mm256_unpacklo_epi16(T[0], T[1]);\
+  __m256i c03d03 = _mm256_unpacklo_epi16(T[2], T[3]);\
+  __m256i e03f03 = _mm256_unpacklo_epi16(T[4], T[5]);\
+  __m256i g03h03 = _mm256_unpacklo_epi16(T[6], T[7]);\
+  __m256i a47b47 = _mm256_unpackhi_epi16(T[0], T[1]);\
+  __m256i c47d47 = _mm256_unpackhi_epi16(T[2], T[3]);\
+  __m256i e47f47 = _mm256_unpackhi_epi16(T[4], T[5]);\
+  __m256i g47h47 = _mm256_unpackhi_epi16(T[6], T[7]);\
+\
+  __m256i a01b01c01d01 = _mm256_unpacklo_epi32(a03b03, c03d03);\
+  __m256i a23b23c23d23 = _mm256_unpackhi_epi32(a03b03, c03d03);\
+  __m256i e01f01g01h01 = _mm256_unpacklo_epi32(e03f03, g03h03);\
+  __m256i e23f23g23h23 = _mm256_unpackhi_epi32(e03f03, g03h03);\
+  __m256i a45b45c45d45 = _mm256_unpacklo_epi32(a47b47, c47d47);\
+  __m256i a67b67c67d67 = _mm256_unpackhi_epi32(a47b47, c47d47);\
+  __m256i e45f45g45h45 = _mm256_unpacklo_epi32(e47f47, g47h47);\
+  __m256i e67f67g67h67 = _mm256_unpackhi_epi32(e47f47, g47h47);\
+\
+  T[0] = _mm256_unpacklo_epi64(a01b01c01d01, e01f01g01h01);\
+  T[1] = _mm256_unpackhi_epi64(a01b01c01d01, e01f01g01h01);\
+  T[2] = _mm256_unpacklo_epi64(a23b23c23d23, e23f23g23h23);\
+  T[3] = _mm256_unpackhi_epi64(a23b23c23d23, e23f23g23h23);\
+  T[4] = _mm256_unpacklo_epi64(a45b45c45d45, e45f45g45h45);\
+  T[5] = _mm256_unpackhi_epi64(a45b45c45d45, e45f45g45h45);\
+  T[6] = _mm256_unpacklo_epi64(a67b67c67d67, e67f67g67h67);\
+  T[7] = _mm256_unpackhi_epi64(a67b67c67d67, e67f67g67h67);\
+}\
+
+#define DBLF_BC_LINE0_AVX2(x)     _mm256_shufflehi_epi16( _mm256_shufflelo_epi16( x, 0x00 ), 0x00 )
+#define DBLF_BC_LINE3_AVX2(x)     _mm256_shufflehi_epi16( _mm256_shufflelo_epi16( x, 0xff ), 0xff )
+
+static inline __m256i simdSegsToLanesAVX2( const int a, const int b, const int c, const int d )
+{
+  return _mm256_inserti128_si256( _mm256_castsi128_si256( simdSegsToLanes( a, b ) ), simdSegsToLanes( c, d ), 1 );
+}
+
+/**
+ - Decision and filtering of four 4-line luma segments, m[0..7] holds the samples p3..q3 with one line per lane
+ */
+static inline void simdFilterLuma16LinesAVX2( __m256i* m, const LFSegParam* segs, const ClpRng& clpRng )
+{
+  const __m256i vzero   = _mm256_setzero_si256();
+  const __m256i vone    = _mm256_set1_epi16( 1 );
+  const __m256i vtwo    = _mm256_set1_epi16( 2 );
+  const __m256i vfour   = _mm256_set1_epi16( 4 );
+  const __m256i vmin    = _mm256_set1_epi16( clpRng.min );
+  const __m256i vmax    = _mm256_set1_epi16( clpRng.max );
+
+  const __m256i vtc     = simdSegsToLanesAVX2( segs[0].tc,   segs[1].tc,   segs[2].tc,   segs[3].tc );
+  const __m256i vbeta   = simdSegsToLanesAVX2( segs[0].beta, segs[1].beta, segs[2].beta, segs[3].beta );
+  const __m256i vnoP    = simdSegsToLanesAVX2( segs[0].partPNoFilter ? -1 : 0, segs[1].partPNoFilter ? -1 : 0, segs[2].partPNoFilter ? -1 : 0, segs[3].partPNoFilter ? -1 : 0 );
+  const __m256i vnoQ    = simdSegsToLanesAVX2( segs[0].partQNoFilter ? -1 : 0, segs[1].partQNoFilter ? -1 : 0, segs[2].partQNoFilter ? -1 : 0, segs[3].partQNoFilter ? -1 : 0 );
+
+  // decisions
+  const __m256i vdp     = _mm256_abs_epi16( _mm256_add_epi16( _mm256_sub_epi16( m[1], _mm256_slli_epi16( m[2], 1 ) ), m[3] ) );
+  const __m256i vdq     = _mm256_abs_epi16( _mm256_add_epi16( _mm256_sub_epi16( m[4], _mm256_slli_epi16( m[5], 1 ) ), m[6] ) );
+  const __m256i vdl     = _mm256_add_epi16( vdp, vdq );
+
+  const __m256i vdSeg   = _mm256_add_epi16( DBLF_BC_LINE0_AVX2( vdl ), DBLF_BC_LINE3_AVX2( vdl ) );
+  const __m256i vdpSeg  = _mm256_add_epi16( DBLF_BC_LINE0_AVX2( vdp ), DBLF_BC_LINE3_AVX2( vdp ) );
+  const __m256i vdqSeg  = _mm256_add_epi16( DBLF_BC_LINE0_AVX2( vdq ), DBLF_BC_LINE3_AVX2( vdq ) );
+
+  const __m256i vside   = _mm256_srai_epi16( _mm256_add_epi16( vbeta, _mm256_srai_epi16( vbeta, 1 ) ), 3 );
+  const __m256i vfilt   = _mm256_cmpgt_epi16( vbeta, vdSeg  );
+  const __m256i vfiltP  = _mm256_cmpgt_epi16( vside, vdpSeg );
+  const __m256i vfiltQ  = _mm256_cmpgt_epi16( vside, vdqSeg );
+
+  const __m256i vdStr   = _mm256_add_epi16( _mm256_abs_epi16( _mm256_sub_epi16( m[0], m[3] ) ), _mm256_abs_epi16( _mm256_sub_epi16( m[7], m[4] ) ) );
+  const __m256i vtc5    = _mm256_srai_epi16( _mm256_add_epi16( _mm256_mullo_epi16( vtc, _mm256_set1_epi16( 5 ) ), vone ), 1 );
+  __m256i       vswl    = _mm256_cmpgt_epi16( _mm256_srai_epi16( vbeta, 3 ), vdStr );
+  vswl                  = _mm256_and_si256( vswl, _mm256_cmpgt_epi16( _mm256_srai_epi16( vbeta, 2 ), _mm256_slli_epi16( vdl, 1 ) ) );
+  vswl                  = _mm256_and_si256( vswl, _mm256_cmpgt_epi16( vtc5, _mm256_abs_epi16( _mm256_sub_epi16( m[3], m[4] ) ) ) );
+  const __m256i vsw     = _mm256_and_si256( DBLF_BC_LINE0_AVX2( vswl ), DBLF_BC_LINE3_AVX2( vswl ) );
+
+  // strong filter
+  const __m256i vtc2    = _mm256_slli_epi16( vtc, 1 );
+  const __m256i vsum34  = _mm256_add_epi16( m[3], m[4] );
+  __m256i       vs[6];
+  vs[0] = _mm256_srai_epi16( _mm256_add_epi16( _mm256_add_epi16( _mm256_add_epi16( _mm256_slli_epi16( _mm256_add_epi16( m[2], vsum34 ), 1 ), m[1] ), m[5] ), vfour ), 3 );
+  vs[1] = _mm256_srai_epi16( _mm256_add_epi16( _mm256_add_epi16( _mm256_add_epi16( _mm256_slli_epi16( _mm256_add_epi16( m[5], vsum34 ), 1 ), m[2] ), m[6] ), vfour ), 3 );
+  vs[2] = _mm256_srai_epi16( _mm256_add_epi16( _mm256_add_epi16( _mm256_add_epi16( m[1], m[2] ), vsum34 ), vtwo ), 2 );
+  vs[3] = _mm256_srai_epi16( _mm256_add_epi16( _mm256_add_epi16( _mm256_add_epi16( m[5], m[6] ), vsum34 ), vtwo ), 2 );
+  vs[4] = _mm256_srai_epi16( _mm256_add_epi16( _mm256_add_epi16( _mm256_add_epi16( _mm256_slli_epi16( m[0], 1 ), _mm256_mullo_epi16( m[1], _mm256_set1_epi16( 3 ) ) ), _mm256_add_epi16( m[2], vsum34 ) ), vfour ), 3 );
+  vs[5] = _mm256_srai_epi16( _mm256_add_epi16( _mm256_add_epi16( _mm256_add_epi16( _mm256_slli_epi16( m[7], 1 ), _mm256_mullo_epi16( m[6], _mm256_set1_epi16( 3 ) ) ), _mm256_add_epi16( m[5], vsum34 ) ), vfour ), 3 );
+
+  static const int strongPos[6] = { 3, 4, 2, 5, 1, 6 };
+  for( int i = 0; i < 6; i++ )
+  {
+    const __m256i vorg = m[strongPos[i]];
+    vs[i] = _mm256_min_epi16( _mm256_max_epi16( vs[i], _mm256_sub_epi16( vorg, vtc2 ) ), _mm256_add_epi16( vorg, vtc2 ) );
+  }
+
+  // weak filter
+  __m256i vdelta        = _mm256_sub_epi16( _mm256_mullo_epi16( _mm256_sub_epi16( m[4], m[3] ), _mm256_set1_epi16( 9 ) ), _mm256_mullo_epi16( _mm256_sub_epi16( m[5], m[2] ), _mm256_set1_epi16( 3 ) ) );
+  vdelta                = _mm256_srai_epi16( _mm256_add_epi16( vdelta, _mm256_set1_epi16( 8 ) ), 4 );
+  const __m256i vweak   = _mm256_cmpgt_epi16( _mm256_mullo_epi16( vtc, _mm256_set1_epi16( 10 ) ), _mm256_abs_epi16( vdelta ) );
+  vdelta                = _mm256_min_epi16( _mm256_max_epi16( vdelta, _mm256_sub_epi16( vzero, vtc ) ), vtc );
+
+  const __m256i vtcH    = _mm256_srai_epi16( vtc, 1 );
+  const __m256i vtcHNeg = _mm256_sub_epi16( vzero, vtcH );
+  __m256i vdelta1       = _mm256_srai_epi16( _mm256_add_epi16( _mm256_add_epi16( m[1], m[3] ), vone ), 1 );
+  vdelta1               = _mm256_srai_epi16( _mm256_add_epi16( _mm256_sub_epi16( vdelta1, m[2] ), vdelta ), 1 );
+  vdelta1               = _mm256_min_epi16( _mm256_max_epi16( vdelta1, vtcHNeg ), vtcH );
+  __m256i vdelta2       = _mm256_srai_epi16( _mm256_add_epi16( _mm256_add_epi16( m[6], m[4] ), vone ), 1 );
+  vdelta2               = _mm256_srai_epi16( _mm256_sub_epi16( _mm256_sub_epi16( vdelta2, m[5] ), vdelta ), 1 );
+  vdelta2               = _mm256_min_epi16( _mm256_max_epi16( vdelta2, vtcHNeg ), vtcH );
+
+  const __m256i vw3     = _mm256_min_epi16( _mm256_max_epi16( _mm256_add_epi16( m[3], vdelta  ), vmin ), vmax );
+  const __m256i vw4     = _mm256_min_epi16( _mm256_max_epi16( _mm256_sub_epi16( m[4], vdelta  ), vmin ), vmax );
+  const __m256i vw2     = _mm256_min_epi16( _mm256_max_epi16( _mm256_add_epi16( m[2], vdelta1 ), vmin ), vmax );
+  const __m256i vw5     = _mm256_min_epi16( _mm256_max_epi16( _mm256_add_epi16( m[5], vdelta2 ), vmin ), vmax );
+
+  // selection
+  const __m256i vselS   = _mm256_and_si256( vfilt, vsw );
+  const __m256i vselW   = _mm256_andnot_si256( vsw, _mm256_and_si256( vfilt, vweak ) );
+  const __m256i vselSP  = _mm256_andnot_si256( vnoP, vselS );
+  const __m256i vselSQ  = _mm256_andnot_si256( vnoQ, vselS );
+  const __m256i vselWP  = _mm256_andnot_si256( vnoP, vselW );
+  const __m256i vselWQ  = _mm256_andnot_si256( vnoQ, vselW );
+
+  m[1] = _mm256_blendv_epi8( m[1], vs[4], vselSP );
+  m[2] = _mm256_blendv_epi8( _mm256_blendv_epi8( m[2], vw2, _mm256_and_si256( vselWP, vfiltP ) ), vs[2], vselSP );
+  m[3] = _mm256_blendv_epi8( _mm256_blendv_epi8( m[3], vw3, vselWP ), vs[0], vselSP );
+  m[4] = _mm256_blendv_epi8( _mm256_blendv_epi8( m[4], vw4, vselWQ ), vs[1], vselSQ );
+  m[5] = _mm256_blendv_epi8( _mm256_blendv_epi8( m[5], vw5, _mm256_and_si256( vselWQ, vfiltQ ) ), vs[3], vselSQ );
+  m[6] = _mm256_blendv_epi8( m[6], vs[5], vselSQ );
+}
+#endif
+
+template<X86_VEXT vext>
+static void simdFilterLumaSegs( Pel* piSrc, const int iOffset, const int iSrcStep, const int numSegs, const LFSegParam* segs, const ClpRng& clpRng )
+{
+  if( clpRng.bd > DBLF_SIMD_MAX_BIT_DEPTH )
+  {
+    LoopFilter::filterLumaSegs( piSrc, iOffset, iSrcStep, numSegs, segs, clpRng );
+    return;
+  }
+
+  int iSeg = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    for( ; iSeg + 4 <= numSegs; iSeg += 4 )
+    {
+      const LFSegParam* seg = segs + iSeg;
+      if( seg[0].tc == 0 && seg[1].tc == 0 && seg[2].tc == 0 && seg[3].tc == 0 )
+      {
+        continue;
+      }
+
+      Pel*    src = piSrc + iSrcStep * iSeg * DBLF_LINES_PER_SEG;
+      __m256i m[8];
+
+      if( iOffset == 1 )
+      {
+        // vertical edge: one line per row, rows 0..7 in the lower and rows 8..15 in the upper half
+        for( int i = 0; i < 8; i++ )
+        {
+          m[i] = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( ( const __m128i* ) ( src + i * iSrcStep - 4 ) ) ),
+                                                                  _mm_loadu_si128( ( const __m128i* ) ( src + ( i + 8 ) * iSrcStep - 4 ) ), 1 );
+        }
+        DBLF_TRANSPOSE8x8_AVX2( m );
+        simdFilterLuma16LinesAVX2( m, seg, clpRng );
+        DBLF_TRANSPOSE8x8_AVX2( m );
+        for( int i = 0; i < 8; i++ )
+        {
+          _mm_storeu_si128( ( __m128i* ) ( src + i * iSrcStep - 4 ),       _mm256_castsi256_si128     ( m[i] ) );
+          _mm_storeu_si128( ( __m128i* ) ( src + ( i + 8 ) * iSrcStep - 4 ), _mm256_extracti128_si256( m[i], 1 ) );
+        }
+      }
+      else
+      {
+        // horizontal edge: the lines are consecutive samples of each row
+        for( int i = 0; i < 8; i++ )
+        {
+          m[i] = _mm256_loadu_si256( ( const __m256i* ) ( src + ( i - 4 ) * iOffset ) );
+        }
+        simdFilterLuma16LinesAVX2( m, seg, clpRng );
+        for( int i = 1; i < 7; i++ )
+        {
+          _mm256_storeu_si256( ( __m256i* ) ( src + ( i - 4 ) * iOffset ), m[i] );
+        }
+      }
+    }
+  }
+#endif
+
+  for( ; iSeg + 2 <= numSegs; iSeg += 2 )
+  {
+    const LFSegParam* seg = segs + iSeg;
+    if( seg[0].tc == 0 && seg[1].tc == 0 )
+    {
+      continue;
+    }
+
+    Pel*    src = piSrc + iSrcStep * iSeg * DBLF_LINES_PER_SEG;
+    __m128i m[8];
+
+    if( iOffset == 1 )
+    {
+      // vertical edge: one line per row
+      for( int i = 0; i < 8; i++ )
+      {
+        m[i] = _mm_loadu_si128( ( const __m128i* ) ( src + i * iSrcStep - 4 ) );
+      }
+      TRANSPOSE8x8( m );
+      simdFilterLuma8Lines( m, seg, clpRng );
+      TRANSPOSE8x8( m );
+      for( int i = 0; i < 8; i++ )
+      {
+        _mm_storeu_si128( ( __m128i* ) ( src + i * iSrcStep - 4 ), m[i] );
+      }
+    }
+    else
+    {
+      // horizontal edge: the lines are consecutive samples of each row
+      for( int i = 0; i < 8; i++ )
+      {
+        m[i] = _mm_loadu_si128( ( const __m128i* ) ( src + ( i - 4 ) * iOffset ) );
+      }
+      simdFilterLuma8Lines( m, seg, clpRng );
+      for( int i = 1; i < 7; i++ )
+      {
+        _mm_storeu_si128( ( __m128i* ) ( src + ( i - 4 ) * iOffset ), m[i] );
+      }
+    }
+  }
+
+  if( iSeg < numSegs )
+  {
+    LoopFilter::filterLumaSegs( piSrc + iSrcStep * iSeg * DBLF_LINES_PER_SEG, iOffset, iSrcStep, numSegs - iSeg, segs + iSeg, clpRng );
+  }
+}
+
+template<X86_VEXT vext>
+static void simdFilterChromaSegs( Pel* piSrc, const int iOffset, const int iSrcStep, const int numSegs, const int segLength, const LFSegParam* segs, const ClpRng& clpRng )
+{
+  const int numLines = numSegs * segLength;
+
+  if( clpRng.bd > DBLF_SIMD_MAX_BIT_DEPTH || numLines < 8 )
+  {
+    LoopFilter::filterChromaSegs( piSrc, iOffset, iSrcStep, numSegs, segLength, segs, clpRng );
+    return;
+  }
+
+  const __m128i vzero = _mm_setzero_si128();
+  const __m128i vfour = _mm_set1_epi16( 4 );
+  const __m128i vmin  = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax  = _mm_set1_epi16( clpRng.max );
+
+  int iLine = 0;
+
+  for( ; iLine + 8 <= numLines; iLine += 8 )
+  {
+    int16_t tc[8], noP[8], noQ[8];
+    bool    bAnyFilter = false;
+
+    for( int i = 0; i < 8; i++ )
+    {
+      const LFSegParam& seg = segs[( iLine + i ) / segLength];
+      tc [i]      = seg.tc;
+      noP[i]      = seg.partPNoFilter ? -1 : 0;
+      noQ[i]      = seg.partQNoFilter ? -1 : 0;
+      bAnyFilter |= seg.tc > 0;
+    }
+
+    if( !bAnyFilter )
+    {
+      continue;
+    }
+
+    const __m128i vtc  = _mm_loadu_si128( ( const __m128i* ) tc );
+    const __m128i vnoP = _mm_loadu_si128( ( const __m128i* ) noP );
+    const __m128i vnoQ = _mm_loadu_si128( ( const __m128i* ) noQ );
+
+    Pel*    src = piSrc + iSrcStep * iLine;
+    __m128i m[4];
+
+    if( iOffset == 1 )
+    {
+      // vertical edge: load p1 p0 q0 q1 of 8 rows and transpose
+      __m128i r[8];
+      for( int i = 0; i < 8; i++ )
+      {
+        r[i] = _mm_loadl_epi64( ( const __m128i* ) ( src + i * iSrcStep - 2 ) );
+      }
+      const __m128i r01 = _mm_unpacklo_epi16( r[0], r[1] );
+      const __m128i r23 = _mm_unpacklo_epi16( r[2], r[3] );
+      const __m128i r45 = _mm_unpacklo_epi16( r[4], r[5] );
+      const __m128i r67 = _mm_unpacklo_epi16( r[6], r[7] );
+      const __m128i l03 = _mm_unpacklo_epi32( r01, r23 );
+      const __m128i h03 = _mm_unpackhi_epi32( r01, r23 );
+      const __m128i l47 = _mm_unpacklo_epi32( r45, r67 );
+      const __m128i h47 = _mm_unpackhi_epi32( r45, r67 );
+      m[0] = _mm_unpacklo_epi64( l03, l47 );
+      m[1] = _mm_unpackhi_epi64( l03, l47 );
+      m[2] = _mm_unpacklo_epi64( h03, h47 );
+      m[3] = _mm_unpackhi_epi64( h03, h47 );
+    }
+    else
+    {
+      for( int i = 0; i < 4; i++ )
+      {
+        m[i] = _mm_loadu_si128( ( const __m128i* ) ( src + ( i - 2 ) * iOffset ) );
+      }
+    }
+
+    __m128i vdelta = _mm_add_epi16( _mm_slli_epi16( _mm_sub_epi16( m[2], m[1] ), 2 ), _mm_sub_epi16( m[0], m[3] ) );
+    vdelta         = _mm_srai_epi16( _mm_add_epi16( vdelta, vfour ), 3 );
+    vdelta         = _mm_min_epi16( _mm_max_epi16( vdelta, _mm_sub_epi16( vzero, vtc ) ), vtc );
+
+    const __m128i vp0 = _mm_min_epi16( _mm_max_epi16( _mm_add_epi16( m[1], vdelta ), vmin ), vmax );
+    const __m128i vq0 = _mm_min_epi16( _mm_max_epi16( _mm_sub_epi16( m[2], vdelta ), vmin ), vmax );
+    m[1] = _mm_blendv_epi8( vp0, m[1], vnoP );
+    m[2] = _mm_blendv_epi8( vq0, m[2], vnoQ );
+
+    if( iOffset == 1 )
+    {
+      __m128i vlo = _mm_unpacklo_epi16( m[1], m[2] );
+      __m128i vhi = _mm_unpackhi_epi16( m[1], m[2] );
+      for( int i = 0; i < 4; i++ )
+      {
+        *( int32_t* ) ( src + i * iSrcStep - 1 )       = _mm_extract_epi32( vlo, 0 );
+        *( int32_t* ) ( src + ( i + 4 ) * iSrcStep - 1 ) = _mm_extract_epi32( vhi, 0 );
+        vlo = _mm_srli_si128( vlo, 4 );
+        vhi = _mm_srli_si128( vhi, 4 );
+      }
+    }
+    else
+    {
+      _mm_storeu_si128( ( __m128i* ) ( src - iOffset ), m[1] );
+      _mm_storeu_si128( ( __m128i* ) ( src           ), m[2] );
+    }
+  }
+
+  for( ; iLine < numLines; iLine++ )
+  {
+    const LFSegParam& seg = segs[iLine / segLength];
+    LoopFilter::filterChromaSegs( piSrc + iSrcStep * iLine, iOffset, iSrcStep, 1, 1, &seg, clpRng );
+  }
+}
+
+template <X86_VEXT vext>
+void LoopFilter::_initLoopFilterX86()
+{
+  m_filterLumaSegs   = simdFilterLumaSegs<vext>;
+  m_filterChromaSegs = simdFilterChromaSegs<vext>;
+}
+
+template void LoopFilter::_initLoopFilterX86<SIMDX86>();
+
+#endif //#ifdef TARGET_SIMD_X86
+#endif //#if ENABLE_SIMD_OPT_DBLF
+//! \}
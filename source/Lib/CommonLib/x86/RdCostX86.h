@@ -2289,6 +2289,224 @@ static uint32_t xCalcHAD8x16_AVX2( const Torg *piOrg, const Tcur *piCur, const i
 }
 
 
+#if ENABLE_SIMD_OPT_DIST_MULTI
+// 8x8 Hadamard kept in 16-bit lanes for up to 10-bit input: after the first five butterfly stages
+// the magnitude is at most 1023 * 32, and the last stage is folded into the absolute sum via
+// |a + b| + |a - b| = 2 * max( |a|, |b| ), which gives the exact result without widening to 32 bits
+static inline __m128i xHAD8x8Red_SSE( __m128i m2[8] )
+{
+  __m128i m1[8];
+
+  m1[0] = _mm_add_epi16( m2[0], m2[4] );
+  m1[1] = _mm_add_epi16( m2[1], m2[5] );
+  m1[2] = _mm_add_epi16( m2[2], m2[6] );
+  m1[3] = _mm_add_epi16( m2[3], m2[7] );
+  m1[4] = _mm_sub_epi16( m2[0], m2[4] );
+  m1[5] = _mm_sub_epi16( m2[1], m2[5] );
+  m1[6] = _mm_sub_epi16( m2[2], m2[6] );
+  m1[7] = _mm_sub_epi16( m2[3], m2[7] );
+
+  m2[0] = _mm_add_epi16( m1[0], m1[2] );
+  m2[1] = _mm_add_epi16( m1[1], m1[3] );
+  m2[2] = _mm_sub_epi16( m1[0], m1[2] );
+  m2[3] = _mm_sub_epi16( m1[1], m1[3] );
+  m2[4] = _mm_add_epi16( m1[4], m1[6] );
+  m2[5] = _mm_add_epi16( m1[5], m1[7] );
+  m2[6] = _mm_sub_epi16( m1[4], m1[6] );
+  m2[7] = _mm_sub_epi16( m1[5], m1[7] );
+
+  m1[0] = _mm_add_epi16( m2[0], m2[1] );
+  m1[1] = _mm_sub_epi16( m2[0], m2[1] );
+  m1[2] = _mm_add_epi16( m2[2], m2[3] );
+  m1[3] = _mm_sub_epi16( m2[2], m2[3] );
+  m1[4] = _mm_add_epi16( m2[4], m2[5] );
+  m1[5] = _mm_sub_epi16( m2[4], m2[5] );
+  m1[6] = _mm_add_epi16( m2[6], m2[7] );
+  m1[7] = _mm_sub_epi16( m2[6], m2[7] );
+
+  m2[0] = _mm_unpacklo_epi16( m1[0], m1[1] );
+  m2[1] = _mm_unpacklo_epi16( m1[2], m1[3] );
+  m2[2] = _mm_unpacklo_epi16( m1[4], m1[5] );
+  m2[3] = _mm_unpacklo_epi16( m1[6], m1[7] );
+  m2[4] = _mm_unpackhi_epi16( m1[0], m1[1] );
+  m2[5] = _mm_unpackhi_epi16( m1[2], m1[3] );
+  m2[6] = _mm_unpackhi_epi16( m1[4], m1[5] );
+  m2[7] = _mm_unpackhi_epi16( m1[6], m1[7] );
+
+  m1[0] = _mm_unpacklo_epi32( m2[0], m2[1] );
+  m1[1] = _mm_unpackhi_epi32( m2[0], m2[1] );
+  m1[2] = _mm_unpacklo_epi32( m2[2], m2[3] );
+  m1[3] = _mm_unpackhi_epi32( m2[2], m2[3] );
+  m1[4] = _mm_unpacklo_epi32( m2[4], m2[5] );
+  m1[5] = _mm_unpackhi_epi32( m2[4], m2[5] );
+  m1[6] = _mm_unpacklo_epi32( m2[6], m2[7] );
+  m1[7] = _mm_unpackhi_epi32( m2[6], m2[7] );
+
+  m2[0] = _mm_unpacklo_epi64( m1[0], m1[2] );
+  m2[1] = _mm_unpackhi_epi64( m1[0], m1[2] );
+  m2[2] = _mm_unpacklo_epi64( m1[1], m1[3] );
+  m2[3] = _mm_unpackhi_epi64( m1[1], m1[3] );
+  m2[4] = _mm_unpacklo_epi64( m1[4], m1[6] );
+  m2[5] = _mm_unpackhi_epi64( m1[4], m1[6] );
+  m2[6] = _mm_unpacklo_epi64( m1[5], m1[7] );
+  m2[7] = _mm_unpackhi_epi64( m1[5], m1[7] );
+
+  m1[0] = _mm_add_epi16( m2[0], m2[4] );
+  m1[1] = _mm_add_epi16( m2[1], m2[5] );
+  m1[2] = _mm_add_epi16( m2[2], m2[6] );
+  m1[3] = _mm_add_epi16( m2[3], m2[7] );
+  m1[4] = _mm_sub_epi16( m2[0], m2[4] );
+  m1[5] = _mm_sub_epi16( m2[1], m2[5] );
+  m1[6] = _mm_sub_epi16( m2[2], m2[6] );
+  m1[7] = _mm_sub_epi16( m2[3], m2[7] );
+
+  m2[0] = _mm_add_epi16( m1[0], m1[2] );
+  m2[1] = _mm_add_epi16( m1[1], m1[3] );
+  m2[2] = _mm_sub_epi16( m1[0], m1[2] );
+  m2[3] = _mm_sub_epi16( m1[1], m1[3] );
+  m2[4] = _mm_add_epi16( m1[4], m1[6] );
+  m2[5] = _mm_add_epi16( m1[5], m1[7] );
+  m2[6] = _mm_sub_epi16( m1[4], m1[6] );
+  m2[7] = _mm_sub_epi16( m1[5], m1[7] );
+
+  const __m128i vone = _mm_set1_epi16( 1 );
+  __m128i iSum = _mm_madd_epi16( _mm_max_epi16( _mm_abs_epi16( m2[0] ), _mm_abs_epi16( m2[1] ) ), vone );
+  iSum = _mm_add_epi32( iSum, _mm_madd_epi16( _mm_max_epi16( _mm_abs_epi16( m2[2] ), _mm_abs_epi16( m2[3] ) ), vone ) );
+  iSum = _mm_add_epi32( iSum, _mm_madd_epi16( _mm_max_epi16( _mm_abs_epi16( m2[4] ), _mm_abs_epi16( m2[5] ) ), vone ) );
+  iSum = _mm_add_epi32( iSum, _mm_madd_epi16( _mm_max_epi16( _mm_abs_epi16( m2[6] ), _mm_abs_epi16( m2[7] ) ), vone ) );
+
+  iSum = _mm_hadd_epi32( iSum, iSum );
+  iSum = _mm_hadd_epi32( iSum, iSum );
+
+  return iSum;
+}
+
+// one 8x8 candidate against original rows already held in registers
+static inline uint32_t xCalcHAD8x8Red_SSE( const __m128i org[8], const Pel *piCur, const int iStrideCur )
+{
+  __m128i m2[8];
+
+  for( int k = 0; k < 8; k++ )
+  {
+    m2[k] = _mm_sub_epi16( org[k], _mm_loadu_si128( ( const __m128i* ) piCur ) );
+    piCur += iStrideCur;
+  }
+
+  uint32_t sad = _mm_cvtsi128_si32( xHAD8x8Red_SSE( m2 ) ) << 1;
+  return ( ( sad + 2 ) >> 2 );
+}
+
+#ifdef USE_AVX2
+// AVX2 counterpart of xHAD8x8Red_SSE, transforming one 8x8 block in each 128-bit lane
+static inline __m256i xHAD8x8Red_AVX2( __m256i m2[8] )
+{
+  __m256i m1[8];
+
+  m1[0] = _mm256_add_epi16( m2[0], m2[4] );
+  m1[1] = _mm256_add_epi16( m2[1], m2[5] );
+  m1[2] = _mm256_add_epi16( m2[2], m2[6] );
+  m1[3] = _mm256_add_epi16( m2[3], m2[7] );
+  m1[4] = _mm256_sub_epi16( m2[0], m2[4] );
+  m1[5] = _mm256_sub_epi16( m2[1], m2[5] );
+  m1[6] = _mm256_sub_epi16( m2[2], m2[6] );
+  m1[7] = _mm256_sub_epi16( m2[3], m2[7] );
+
+  m2[0] = _mm256_add_epi16( m1[0], m1[2] );
+  m2[1] = _mm256_add_epi16( m1[1], m1[3] );
+  m2[2] = _mm256_sub_epi16( m1[0], m1[2] );
+  m2[3] = _mm256_sub_epi16( m1[1], m1[3] );
+  m2[4] = _mm256_add_epi16( m1[4], m1[6] );
+  m2[5] = _mm256_add_epi16( m1[5], m1[7] );
+  m2[6] = _mm256_sub_epi16( m1[4], m1[6] );
+  m2[7] = _mm256_sub_epi16( m1[5], m1[7] );
+
+  m1[0] = _mm256_add_epi16( m2[0], m2[1] );
+  m1[1] = _mm256_sub_epi16( m2[0], m2[1] );
+  m1[2] = _mm256_add_epi16( m2[2], m2[3] );
+  m1[3] = _mm256_sub_epi16( m2[2], m2[3] );
+  m1[4] = _mm256_add_epi16( m2[4], m2[5] );
+  m1[5] = _mm256_sub_epi16( m2[4], m2[5] );
+  m1[6] = _mm256_add_epi16( m2[6], m2[7] );
+  m1[7] = _mm256_sub_epi16( m2[6], m2[7] );
+
+  m2[0] = _mm256_unpacklo_epi16( m1[0], m1[1] );
+  m2[1] = _mm256_unpacklo_epi16( m1[2], m1[3] );
+  m2[2] = _mm256_unpacklo_epi16( m1[4], m1[5] );
+  m2[3] = _mm256_unpacklo_epi16( m1[6], m1[7] );
+  m2[4] = _mm256_unpackhi_epi16( m1[0], m1[1] );
+  m2[5] = _mm256_unpackhi_epi16( m1[2], m1[3] );
+  m2[6] = _mm256_unpackhi_epi16( m1[4], m1[5] );
+  m2[7] = _mm256_unpackhi_epi16( m1[6], m1[7] );
+
+  m1[0] = _mm256_unpacklo_epi32( m2[0], m2[1] );
+  m1[1] = _mm256_unpackhi_epi32( m2[0], m2[1] );
+  m1[2] = _mm256_unpacklo_epi32( m2[2], m2[3] );
+  m1[3] = _mm256_unpackhi_epi32( m2[2], m2[3] );
+  m1[4] = _mm256_unpacklo_epi32( m2[4], m2[5] );
+  m1[5] = _mm256_unpackhi_epi32( m2[4], m2[5] );
+  m1[6] = _mm256_unpacklo_epi32( m2[6], m2[7] );
+  m1[7] = _mm256_unpackhi_epi32( m2[6], m2[7] );
+
+  m2[0] = _mm256_unpacklo_epi64( m1[0], m1[2] );
+  m2[1] = _mm256_unpackhi_epi64( m1[0], m1[2] );
+  m2[2] = _mm256_unpacklo_epi64( m1[1], m1[3] );
+  m2[3] = _mm256_unpackhi_epi64( m1[1], m1[3] );
+  m2[4] = _mm256_unpacklo_epi64( m1[4], m1[6] );
+  m2[5] = _mm256_unpackhi_epi64( m1[4], m1[6] );
+  m2[6] = _mm256_unpacklo_epi64( m1[5], m1[7] );
+  m2[7] = _mm256_unpackhi_epi64( m1[5], m1[7] );
+
+  m1[0] = _mm256_add_epi16( m2[0], m2[4] );
+  m1[1] = _mm256_add_epi16( m2[1], m2[5] );
+  m1[2] = _mm256_add_epi16( m2[2], m2[6] );
+  m1[3] = _mm256_add_epi16( m2[3], m2[7] );
+  m1[4] = _mm256_sub_epi16( m2[0], m2[4] );
+  m1[5] = _mm256_sub_epi16( m2[1], m2[5] );
+  m1[6] = _mm256_sub_epi16( m2[2], m2[6] );
+  m1[7] = _mm256_sub_epi16( m2[3], m2[7] );
+
+  m2[0] = _mm256_add_epi16( m1[0], m1[2] );
+  m2[1] = _mm256_add_epi16( m1[1], m1[3] );
+  m2[2] = _mm256_sub_epi16( m1[0], m1[2] );
+  m2[3] = _mm256_sub_epi16( m1[1], m1[3] );
+  m2[4] = _mm256_add_epi16( m1[4], m1[6] );
+  m2[5] = _mm256_add_epi16( m1[5], m1[7] );
+  m2[6] = _mm256_sub_epi16( m1[4], m1[6] );
+  m2[7] = _mm256_sub_epi16( m1[5], m1[7] );
+
+  const __m256i vone = _mm256_set1_epi16( 1 );
+  __m256i iSum = _mm256_madd_epi16( _mm256_max_epi16( _mm256_abs_epi16( m2[0] ), _mm256_abs_epi16( m2[1] ) ), vone );
+  iSum = _mm256_add_epi32( iSum, _mm256_madd_epi16( _mm256_max_epi16( _mm256_abs_epi16( m2[2] ), _mm256_abs_epi16( m2[3] ) ), vone ) );
+  iSum = _mm256_add_epi32( iSum, _mm256_madd_epi16( _mm256_max_epi16( _mm256_abs_epi16( m2[4] ), _mm256_abs_epi16( m2[5] ) ), vone ) );
+  iSum = _mm256_add_epi32( iSum, _mm256_madd_epi16( _mm256_max_epi16( _mm256_abs_epi16( m2[6] ), _mm256_abs_epi16( m2[7] ) ), vone ) );
+
+  iSum = _mm256_hadd_epi32( iSum, iSum );
+  iSum = _mm256_hadd_epi32( iSum, iSum );
+
+  return iSum;
+}
+
+// two 8x8 blocks at once: lane 0 scores curA, lane 1 scores curB against the respective org lane
+static inline void xCalcHAD8x8x2Red_AVX2( const __m256i org[8], const Pel *piCurA, const Pel *piCurB, const int iStrideCur, uint32_t sad[2] )
+{
+  __m256i m2[8];
+
+  for( int k = 0; k < 8; k++ )
+  {
+    const __m256i r1 = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( ( const __m128i* ) piCurA ) ), _mm_loadu_si128( ( const __m128i* ) piCurB ), 1 );
+    m2[k] = _mm256_sub_epi16( org[k], r1 );
+    piCurA += iStrideCur;
+    piCurB += iStrideCur;
+  }
+
+  const __m256i iSum = xHAD8x8Red_AVX2( m2 );
+
+  sad[0] = ( ( ( uint32_t ) _mm_cvtsi128_si32( _mm256_castsi256_si128( iSum ) ) << 1 ) + 2 ) >> 2;
+  sad[1] = ( ( ( uint32_t ) _mm_cvtsi128_si32( _mm256_extracti128_si256( iSum, 1 ) ) << 1 ) + 2 ) >> 2;
+}
+#endif
+#endif
+
 template< typename Torg, typename Tcur, X86_VEXT vext >
 Distortion RdCost::xGetHADs_SIMD( const DistParam &rcDtParam )
 {
@@ -2366,6 +2584,42 @@ Distortion RdCost::xGetHADs_SIMD( const DistParam &rcDtParam )
       piCur += iStrideCur * 8;
     }
   }
+#if ENABLE_SIMD_OPT_DIST_MULTI
+  else if( ( ( ( iRows | iCols ) & 7 ) == 0 ) && ( iRows == iCols || !rcDtParam.isQtbt ) )
+  {
+    __m128i org[8];
+    for( y = 0; y < iRows; y += 8 )
+    {
+      x = 0;
+#ifdef USE_AVX2
+      if( vext >= AVX2 )
+      {
+        __m256i org2[8];
+        uint32_t sad[2];
+        for( ; x + 16 <= iCols; x += 16 )
+        {
+          for( int k = 0; k < 8; k++ )
+          {
+            org2[k] = _mm256_loadu_si256( ( const __m256i* ) &piOrg[k * iStrideOrg + x] );
+          }
+          xCalcHAD8x8x2Red_AVX2( org2, ( const Pel* ) &piCur[x], ( const Pel* ) &piCur[x + 8], iStrideCur, sad );
+          uiSum += sad[0] + sad[1];
+        }
+      }
+#endif
+      for( ; x < iCols; x += 8 )
+      {
+        for( int k = 0; k < 8; k++ )
+        {
+          org[k] = _mm_loadu_si128( ( const __m128i* ) &piOrg[k * iStrideOrg + x] );
+        }
+        uiSum += xCalcHAD8x8Red_SSE( org, ( const Pel* ) &piCur[x], iStrideCur );
+      }
+      piOrg += iStrideOrg << 3;
+      piCur += iStrideCur << 3;
+    }
+  }
+#else
   else if( vext >= AVX2 && ( ( ( iRows | iCols ) & 15 ) == 0 ) && ( iRows == iCols || !rcDtParam.isQtbt ) )
   {
     int  iOffsetOrg = iStrideOrg << 4;
@@ -2394,6 +2648,7 @@ Distortion RdCost::xGetHADs_SIMD( const DistParam &rcDtParam )
       piCur += iOffsetCur;
     }
   }
+#endif
   else if( ( iRows % 4 == 0 ) && ( iCols % 4 == 0 ) )
   {
     int  iOffsetOrg = iStrideOrg << 2;
@@ -2435,6 +2690,78 @@ Distortion RdCost::xGetHADs_SIMD( const DistParam &rcDtParam )
 #endif
 }
 
+#if ENABLE_SIMD_OPT_DIST_MULTI
+template< X86_VEXT vext >
+void RdCost::xGetHADsMulti_SIMD( const DistParam &rcDtParam, const Pel* const* curBufs, int numCur, Distortion* dist )
+{
+  const int iRows = rcDtParam.org.height;
+  const int iCols = rcDtParam.org.width;
+
+  // only the 8x8 tiling of xGetHADs_SIMD is batched, the other shapes are scored one by one
+  if( rcDtParam.bitDepth > 10 || rcDtParam.applyWeight || rcDtParam.step != 1 || ( ( iRows | iCols ) & 7 ) != 0 || ( rcDtParam.isQtbt && iRows != iCols ) )
+  {
+    xGetDistMulti( rcDtParam, curBufs, numCur, dist );
+    return;
+  }
+
+  const Pel* piOrg      = rcDtParam.org.buf;
+  const int  iStrideOrg = rcDtParam.org.stride;
+  const int  iStrideCur = rcDtParam.cur.stride;
+
+  for( int i = 0; i < numCur; i++ )
+  {
+    dist[i] = 0;
+  }
+
+  for( int y = 0; y < iRows; y += 8 )
+  {
+    for( int x = 0; x < iCols; x += 8 )
+    {
+      // the original tile is loaded once and shared by all candidates
+      const int offCur = y * iStrideCur + x;
+      __m128i org[8];
+      for( int k = 0; k < 8; k++ )
+      {
+        org[k] = _mm_loadu_si128( ( const __m128i* ) &piOrg[k * iStrideOrg + x] );
+      }
+
+      int i = 0;
+#ifdef USE_AVX2
+      if( vext >= AVX2 )
+      {
+        __m256i org2[8];
+        uint32_t sad[2];
+        for( int k = 0; k < 8; k++ )
+        {
+          org2[k] = _mm256_inserti128_si256( _mm256_castsi128_si256( org[k] ), org[k], 1 );
+        }
+        for( ; i + 1 < numCur; i += 2 )
+        {
+          xCalcHAD8x8x2Red_AVX2( org2, curBufs[i] + offCur, curBufs[i + 1] + offCur, iStrideCur, sad );
+          dist[i]     += sad[0];
+          dist[i + 1] += sad[1];
+        }
+      }
+#endif
+      for( ; i < numCur; i++ )
+      {
+        dist[i] += xCalcHAD8x8Red_SSE( org, curBufs[i] + offCur, iStrideCur );
+      }
+    }
+    piOrg += iStrideOrg << 3;
+  }
+
+  for( int i = 0; i < numCur; i++ )
+  {
+#if DISTORTION_LAMBDA_BUGFIX
+    dist[i] >>= DISTORTION_PRECISION_ADJUSTMENT( rcDtParam.bitDepth );
+#else
+    dist[i] >>= DISTORTION_PRECISION_ADJUSTMENT( rcDtParam.bitDepth - 8 );
+#endif
+  }
+}
+#endif
+
 template <X86_VEXT vext>
 void RdCost::_initRdCostX86()
 {
@@ -2470,6 +2797,17 @@ void RdCost::_initRdCostX86()
   m_afpDistortFunc[DF_HAD32]   = RdCost::xGetHADs_SIMD<Pel, Pel, vext>;
   m_afpDistortFunc[DF_HAD64]   = RdCost::xGetHADs_SIMD<Pel, Pel, vext>;
   m_afpDistortFunc[DF_HAD16N]  = RdCost::xGetHADs_SIMD<Pel, Pel, vext>;
+
+#if ENABLE_SIMD_OPT_DIST_MULTI
+  m_afpDistortFuncMulti[DF_HAD]     = RdCost::xGetHADsMulti_SIMD<vext>;
+  m_afpDistortFuncMulti[DF_HAD2]    = RdCost::xGetHADsMulti_SIMD<vext>;
+  m_afpDistortFuncMulti[DF_HAD4]    = RdCost::xGetHADsMulti_SIMD<vext>;
+  m_afpDistortFuncMulti[DF_HAD8]    = RdCost::xGetHADsMulti_SIMD<vext>;
+  m_afpDistortFuncMulti[DF_HAD16]   = RdCost::xGetHADsMulti_SIMD<vext>;
+  m_afpDistortFuncMulti[DF_HAD32]   = RdCost::xGetHADsMulti_SIMD<vext>;
+  m_afpDistortFuncMulti[DF_HAD64]   = RdCost::xGetHADsMulti_SIMD<vext>;
+  m_afpDistortFuncMulti[DF_HAD16N]  = RdCost::xGetHADsMulti_SIMD<vext>;
+#endif
 }
 
 template void RdCost::_initRdCostX86<SIMDX86>();
@@ -353,6 +353,9 @@ DecLib::DecLib()
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   , m_cacheModel()
 #endif
+  , m_mcFetchStats()
+  , m_mcFetchStatsEnabled(false)
+  , m_refPicPadding(true)
   , m_pcPic(NULL)
   , m_prevPOC(MAX_INT)
   , m_prevTid0POC(0)
@@ -435,17 +438,24 @@ void DecLib::deletePicBuffer ( )
   m_cacheModel.reportSequence( );
   m_cacheModel.destroy( );
 #endif
+  if( m_mcFetchStatsEnabled )
+  {
+    m_mcFetchStats.reportPicture();
+    m_mcFetchStats.reportSequence();
+  }
 }
 
 Picture* DecLib::xGetNewPicBuffer ( const SPS &sps, const PPS &pps, const uint32_t temporalLayer )
 {
   Picture * pcPic = nullptr;
+  // without padding the motion compensation clamps the reference coordinates to the picture
+  const unsigned margin = m_refPicPadding ? sps.getMaxCUWidth() + 16 : 0;
   m_iMaxRefPicNum = sps.getMaxDecPicBuffering(temporalLayer);     // m_uiMaxDecPicBuffering has the space for the picture currently being decoded
   if (m_cListPic.size() < (uint32_t)m_iMaxRefPicNum)
   {
     pcPic = new Picture();
 
-    pcPic->create( sps.getChromaFormatIdc(), Size( sps.getPicWidthInLumaSamples(), sps.getPicHeightInLumaSamples() ), sps.getMaxCUWidth(), sps.getMaxCUWidth() + 16, true );
+    pcPic->create( sps.getChromaFormatIdc(), Size( sps.getPicWidthInLumaSamples(), sps.getPicHeightInLumaSamples() ), sps.getMaxCUWidth(), margin, true );
 
     m_cListPic.push_back( pcPic );
 
@@ -481,14 +491,14 @@ Picture* DecLib::xGetNewPicBuffer ( const SPS &sps, const PPS &pps, const uint32
 
     m_cListPic.push_back( pcPic );
 
-    pcPic->create( sps.getChromaFormatIdc(), Size( sps.getPicWidthInLumaSamples(), sps.getPicHeightInLumaSamples() ), sps.getMaxCUWidth(), sps.getMaxCUWidth() + 16, true );
+    pcPic->create( sps.getChromaFormatIdc(), Size( sps.getPicWidthInLumaSamples(), sps.getPicHeightInLumaSamples() ), sps.getMaxCUWidth(), margin, true );
   }
   else
   {
     if( !pcPic->Y().Size::operator==( Size( sps.getPicWidthInLumaSamples(), sps.getPicHeightInLumaSamples() ) ) || pcPic->cs->pcv->maxCUWidth != sps.getMaxCUWidth() || pcPic->cs->pcv->maxCUHeight != sps.getMaxCUHeight() )
     {
       pcPic->destroy();
-      pcPic->create( sps.getChromaFormatIdc(), Size( sps.getPicWidthInLumaSamples(), sps.getPicHeightInLumaSamples() ), sps.getMaxCUWidth(), sps.getMaxCUWidth() + 16, true );
+      pcPic->create( sps.getChromaFormatIdc(), Size( sps.getPicWidthInLumaSamples(), sps.getPicHeightInLumaSamples() ), sps.getMaxCUWidth(), margin, true );
     }
   }
 
@@ -511,6 +521,9 @@ void DecLib::executeLoopFilters()
 
   // deblocking filter
   m_cLoopFilter.loopFilterPic( cs );
+#if ENABLE_COMPRESSED_COL_MOTION
+  cs.compressColMotion();
+#endif
 
   if( cs.sps->getUseSAO() )
   {
@@ -559,6 +572,7 @@ void DecLib::finishPicture(int& poc, PicList*& rpcListPic, MsgLevel msgl )
          c,
          pcSlice->getSliceQp() );
   msg( msgl, "[DT %6.3f] ", pcSlice->getProcessingTime() );
+  msg( msgl, "[LF %6.3f] ", m_cLoopFilter.getPicProcessingTime() );
 
   for (int iRefList = 0; iRefList < 2; iRefList++)
   {
@@ -1149,6 +1163,7 @@ bool DecLib::xDecodeSlice(InputNALUnit &nalu, int &iSkipFrame, int iPOCLastDispl
 
 
   //  Decode a picture
+  m_mcFetchStats.setPOC( pcSlice->getPOC() );
   m_cSliceDecoder.decompressSlice( pcSlice, &(nalu.getBitstream()) );
 
   m_bFirstSliceInPicture = false;
@@ -1252,6 +1267,10 @@ bool DecLib::decode(InputNALUnit& nalu, int& iSkipFrame, int& iPOCLastDisplay)
         m_cacheModel.clear( );
       }
 #endif
+      if( ret && m_mcFetchStatsEnabled )
+      {
+        m_mcFetchStats.reportPicture();
+      }
       return ret;
 
     case NAL_UNIT_EOS:
@@ -103,6 +103,9 @@ private:
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   CacheModel              m_cacheModel;
 #endif
+  MCFetchStats            m_mcFetchStats;
+  bool                    m_mcFetchStatsEnabled;          ///< collect and report the reference fetches of the motion compensation
+  bool                    m_refPicPadding;                ///< store the pictures with a padded margin, otherwise the motion compensation clamps the coordinates
 
   bool isSkipPictureForBLA(int& iPOCLastDisplay);
   bool isRandomAccessSkipPicture(int& iSkipFrame,  int& iPOCLastDisplay);
@@ -134,6 +137,8 @@ public:
   void  destroy ();
 
   void  setDecodedPictureHashSEIEnabled(int enabled) { m_decodedPictureHashSEIEnabled=enabled; }
+  void  setMCFetchStatsEnabled(bool enabled)          { m_mcFetchStatsEnabled = enabled; m_cInterPred.setFetchStats( enabled ? &m_mcFetchStats : nullptr ); }
+  void  setRefPicPadding(bool enabled)                { m_refPicPadding = enabled; }
 
   void  init(
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
@@ -820,12 +820,17 @@ void HLSyntaxReader::parseSPSNext( SPSNext& spsNext, const bool usePCM )
 #endif
 #if JVET_K_AFFINE
   READ_FLAG( symbol,    "affine_flag" );                            spsNext.setUseAffine              ( symbol != 0 );
-#if JVET_K0337_AFFINE_6PARA
   if ( spsNext.getUseAffine() )
   {
+#if JVET_K0337_AFFINE_6PARA
 	  READ_UVLC( symbol,  "affine_type_flag" );                       spsNext.setUseAffineType          ( symbol );
-  }
 #endif
+	  READ_FLAG( symbol,  "affine_adaptive_subblock_flag" );          spsNext.setUseAffineAdaptiveSubblock( symbol != 0 );
+  }
+  else
+  {
+	  spsNext.setUseAffineAdaptiveSubblock( false );
+  }
 #endif
 
   for( int k = 0; k < SPSNext::NumReservedFlags; k++ )
@@ -156,6 +156,254 @@ void AQpPreanalyzer::preanalyze( Picture* pcEPic )
 }
 
 
+/** SAD of a block against a displaced block of the same size in a reference plane
+ */
+static uint32_t xGetBlockSad( const CPelBuf& cur, const CPelBuf& ref, const int posX, const int posY, const int blkW, const int blkH, const Mv& mv )
+{
+  const Pel* pCur = cur.bufAt( posX, posY );
+  const Pel* pRef = ref.bufAt( posX + mv.getHor(), posY + mv.getVer() );
+  uint32_t sad = 0;
+  for( int y = 0; y < blkH; y++ )
+  {
+    for( int x = 0; x < blkW; x++ )
+    {
+      sad += abs( pCur[x] - pRef[x] );
+    }
+    pCur += cur.stride;
+    pRef += ref.stride;
+  }
+  return sad;
+}
+
+/** Full-pel block search: the best of the given predictors is refined by a full search of +-searchRange
+ * \param numCands number of predictors in cands, the zero vector is always tested
+ * \param bestMv   returns the best motion vector
+ * \return SAD of the best motion vector
+ */
+static uint32_t xSearchBlock( const CPelBuf& cur, const CPelBuf& ref, const int posX, const int posY, const int blkW, const int blkH,
+                              const Mv* cands, const int numCands, const int searchRange, Mv& bestMv )
+{
+  const int minX = -posX, maxX = ref.width  - blkW - posX;
+  const int minY = -posY, maxY = ref.height - blkH - posY;
+
+  Mv       center;
+  uint32_t bestSad = xGetBlockSad( cur, ref, posX, posY, blkW, blkH, center );
+  for( int n = 0; n < numCands; n++ )
+  {
+    const Mv cand( Clip3( minX, maxX, cands[n].getHor() ), Clip3( minY, maxY, cands[n].getVer() ) );
+    const uint32_t sad = xGetBlockSad( cur, ref, posX, posY, blkW, blkH, cand );
+    if( sad < bestSad )
+    {
+      bestSad = sad;
+      center  = cand;
+    }
+  }
+
+  bestMv = center;
+  for( int mvY = std::max( minY, center.getVer() - searchRange ); mvY <= std::min( maxY, center.getVer() + searchRange ); mvY++ )
+  {
+    for( int mvX = std::max( minX, center.getHor() - searchRange ); mvX <= std::min( maxX, center.getHor() + searchRange ); mvX++ )
+    {
+      const uint32_t sad = xGetBlockSad( cur, ref, posX, posY, blkW, blkH, Mv( mvX, mvY ) );
+      if( sad < bestSad )
+      {
+        bestSad = sad;
+        bestMv  = Mv( mvX, mvY );
+      }
+    }
+  }
+
+  return bestSad;
+}
+
+/** Estimate the coding complexity of each CTU from a half resolution analysis of the source picture.
+ *  Every 8x8 block of the downsampled luma plane is costed as the smaller of an intra cost (SAD against
+ *  the block mean) and an inter cost (best SAD of a small full-pel search in the downsampled previous
+ *  source picture). The block costs are accumulated per CTU into picture->m_lookaheadCostCtu.
+ * \param picture    picture to be analysed, with source pyramid
+ * \param refPicture previous source picture in display order, with source pyramid
+ */
+void RCPreanalyzer::preanalyze( Picture* picture, const Picture* refPicture )
+{
+  static const int blkSize      = 8;
+  static const int searchRange  = 4;
+
+  const PreCalcValues& pcv = *picture->cs->pcv;
+  const CPelBuf cur        = picture->getOrigPyramidBuf( 0 );
+  const CPelBuf ref        = refPicture->getOrigPyramidBuf( 0 );
+  const int width          = cur.width;
+  const int height         = cur.height;
+  const int ctuSize        = pcv.maxCUWidth >> 1;
+  const int widthInBlks    = ( width  + blkSize - 1 ) / blkSize;
+  const int heightInBlks   = ( height + blkSize - 1 ) / blkSize;
+
+  picture->m_lookaheadCostCtu.assign( pcv.sizeInCtus, 0.0 );
+
+  std::vector<Mv> blkMv( widthInBlks * heightInBlks );
+
+  for( int by = 0; by < heightInBlks; by++ )
+  {
+    for( int bx = 0; bx < widthInBlks; bx++ )
+    {
+      const int posX   = bx * blkSize;
+      const int posY   = by * blkSize;
+      const int blkW   = std::min( blkSize, width  - posX );
+      const int blkH   = std::min( blkSize, height - posY );
+      const Pel* pCur  = cur.bufAt( posX, posY );
+
+      int sum = 0;
+      for( int y = 0; y < blkH; y++ )
+      {
+        for( int x = 0; x < blkW; x++ )
+        {
+          sum += pCur[y * cur.stride + x];
+        }
+      }
+      const int mean = sum / ( blkW * blkH );
+
+      uint32_t cost = 0;
+      for( int y = 0; y < blkH; y++ )
+      {
+        for( int x = 0; x < blkW; x++ )
+        {
+          cost += abs( pCur[y * cur.stride + x] - mean );
+        }
+      }
+
+      // search around the best of the zero, left and above predictors
+      Mv  cands[2];
+      int numCands = 0;
+      if( bx > 0 ) cands[numCands++] = blkMv[by * widthInBlks + bx - 1];
+      if( by > 0 ) cands[numCands++] = blkMv[( by - 1 ) * widthInBlks + bx];
+
+      const uint32_t interCost = xSearchBlock( cur, ref, posX, posY, blkW, blkH, cands, numCands, searchRange, blkMv[by * widthInBlks + bx] );
+      cost = std::min( cost, interCost );
+
+      const int ctuAddr = ( posY / ctuSize ) * pcv.widthInCtus + posX / ctuSize;
+      picture->m_lookaheadCostCtu[ctuAddr] += cost;
+    }
+  }
+}
+
+/** Sum of the CTU-wise lookahead complexity of a picture
+ * \param picture analysed picture
+ * \return picture complexity, 0 if the picture has not been analysed
+ */
+double RCPreanalyzer::getPicCost( const Picture* picture )
+{
+  double cost = 0.0;
+  for( const double ctuCost : picture->m_lookaheadCostCtu )
+  {
+    cost += ctuCost;
+  }
+  return cost;
+}
+
+/** Hierarchical motion pre-search of a picture against all of its reference pictures.
+ *  Every Picture::PRE_SEARCH_BLK_SIZE luma block is searched at 1/16 resolution (quarter width and height)
+ *  around the zero vector and the already searched neighbours, then refined at 1/4 resolution. The resulting
+ *  integer-pel vectors are stored in picture->m_preSearchMv and used as extra start points of the
+ *  integer and affine motion estimation.
+ * \param picture picture to be analysed, with source pyramid
+ * \param slice   slice holding the reference picture lists
+ */
+void MEPreanalyzer::preanalyze( Picture* picture, const Slice& slice )
+{
+  static const int searchRangeCoarse = 8;   // +-32 luma samples
+  static const int searchRangeFine   = 2;
+
+  const int blkSize       = Picture::PRE_SEARCH_BLK_SIZE;
+  const int widthInBlks   = ( picture->lwidth()  + blkSize - 1 ) / blkSize;
+  const int heightInBlks  = ( picture->lheight() + blkSize - 1 ) / blkSize;
+
+  for( int list = 0; list < NUM_REF_PIC_LIST_01; list++ )
+  {
+    for( int refIdx = 0; refIdx < MAX_NUM_REF; refIdx++ )
+    {
+      picture->m_preSearchMv[list][refIdx].clear();
+    }
+  }
+
+  for( int list = 0; list < NUM_REF_PIC_LIST_01; list++ )
+  {
+    const RefPicList refList = RefPicList( list );
+
+    for( int refIdx = 0; refIdx < slice.getNumRefIdx( refList ); refIdx++ )
+    {
+      const Picture* refPic = slice.getRefPic( refList, refIdx );
+      std::vector<Mv>& field = picture->m_preSearchMv[list][refIdx];
+
+      if( !refPic->hasOrigPyramid() )
+      {
+        continue;
+      }
+
+      // the same reference picture may be present in both lists
+      int refIdxL0 = -1;
+      for( int idx = 0; list == REF_PIC_LIST_1 && idx < slice.getNumRefIdx( REF_PIC_LIST_0 ); idx++ )
+      {
+        if( slice.getRefPic( REF_PIC_LIST_0, idx ) == refPic )
+        {
+          refIdxL0 = idx;
+          break;
+        }
+      }
+      if( refIdxL0 >= 0 )
+      {
+        field = picture->m_preSearchMv[REF_PIC_LIST_0][refIdxL0];
+        continue;
+      }
+
+      field.resize( widthInBlks * heightInBlks );
+
+      for( int level = Picture::NUM_ORIG_PYRAMID_LEVELS - 1; level >= 0; level-- )
+      {
+        const CPelBuf cur  = picture->getOrigPyramidBuf( level );
+        const CPelBuf ref  = refPic->getOrigPyramidBuf( level );
+        const int     size = blkSize >> ( level + 1 );
+
+        for( int by = 0; by < heightInBlks; by++ )
+        {
+          for( int bx = 0; bx < widthInBlks; bx++ )
+          {
+            const int posX = bx * size;
+            const int posY = by * size;
+            if( posX >= cur.width || posY >= cur.height )
+            {
+              continue;
+            }
+            const int blkW = std::min<int>( size, cur.width  - posX );
+            const int blkH = std::min<int>( size, cur.height - posY );
+            Mv& mv         = field[by * widthInBlks + bx];
+
+            Mv  cands[3];
+            int numCands = 0;
+            if( level == Picture::NUM_ORIG_PYRAMID_LEVELS - 1 )
+            {
+              if( bx > 0 ) cands[numCands++] = field[by * widthInBlks + bx - 1];
+              if( by > 0 ) cands[numCands++] = field[( by - 1 ) * widthInBlks + bx];
+              xSearchBlock( cur, ref, posX, posY, blkW, blkH, cands, numCands, searchRangeCoarse, mv );
+            }
+            else
+            {
+              // the coarse result of this block is scaled up, neighbours are already refined at this level
+              cands[numCands++] = Mv( mv.getHor() << 1, mv.getVer() << 1 );
+              if( bx > 0 ) cands[numCands++] = field[by * widthInBlks + bx - 1];
+              if( by > 0 ) cands[numCands++] = field[( by - 1 ) * widthInBlks + bx];
+              xSearchBlock( cur, ref, posX, posY, blkW, blkH, cands, numCands, searchRangeFine, mv );
+            }
+          }
+        }
+      }
+
+      // half resolution to full resolution integer-pel
+      for( Mv& mv : field )
+      {
+        mv = Mv( mv.getHor() << 1, mv.getVer() << 1 );
+      }
+    }
+  }
+}
 
 //! \}
 
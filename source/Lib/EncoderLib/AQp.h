@@ -91,6 +91,27 @@ public:
   static void preanalyze( Picture* picture );
 };
 
+/// Lookahead complexity analyzer for rate control
+class RCPreanalyzer
+{
+protected:
+  RCPreanalyzer() {}
+  virtual ~RCPreanalyzer() {}
+public:
+  static void preanalyze( Picture* picture, const Picture* refPicture );
+  static double getPicCost( const Picture* picture );
+};
+
+/// Hierarchical motion pre-search used to seed the motion estimation
+class MEPreanalyzer
+{
+protected:
+  MEPreanalyzer() {}
+  virtual ~MEPreanalyzer() {}
+public:
+  static void preanalyze( Picture* picture, const Slice& slice );
+};
+
 //! \}
 
 #endif // __ENCPIC__
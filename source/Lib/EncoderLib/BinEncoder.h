@@ -292,7 +292,7 @@ protected:
 
 
 template <class BinProbModel>
-class TBitEstimator : public BitEstimatorBase
+class TBitEstimator final : public BitEstimatorBase
 {
 public:
   TBitEstimator ();
@@ -1704,10 +1704,11 @@ void CABACWriter::cbf_comp( const CodingStructure& cs, bool cbf, const CompArea&
 //    void  mvd_coding( pu, refList )
 //================================================================================
 
+template<class BinEnc>
 #if JVET_K0357_AMVR
-void CABACWriter::mvd_coding( const Mv &rMvd, uint8_t imv )
+void CABACWriter::mvd_coding_bins( BinEnc& binEnc, const Mv &rMvd, uint8_t imv )
 #else
-void CABACWriter::mvd_coding( const Mv &rMvd )
+void CABACWriter::mvd_coding_bins( BinEnc& binEnc, const Mv &rMvd )
 #endif
 {
   int       horMvd = rMvd.getHor();
@@ -1740,17 +1741,17 @@ void CABACWriter::mvd_coding( const Mv &rMvd )
 #endif
 
   // abs_mvd_greater0_flag[ 0 | 1 ]
-  m_BinEncoder.encodeBin( (horAbs > 0), Ctx::Mvd() );
-  m_BinEncoder.encodeBin( (verAbs > 0), Ctx::Mvd() );
+  binEnc.encodeBin( (horAbs > 0), Ctx::Mvd() );
+  binEnc.encodeBin( (verAbs > 0), Ctx::Mvd() );
 
   // abs_mvd_greater1_flag[ 0 | 1 ]
   if( horAbs > 0 )
   {
-    m_BinEncoder.encodeBin( (horAbs > 1), Ctx::Mvd(1) );
+    binEnc.encodeBin( (horAbs > 1), Ctx::Mvd(1) );
   }
   if( verAbs > 0 )
   {
-    m_BinEncoder.encodeBin( (verAbs > 1), Ctx::Mvd(1) );
+    binEnc.encodeBin( (verAbs > 1), Ctx::Mvd(1) );
   }
 
   // abs_mvd_minus2[ 0 | 1 ] and mvd_sign_flag[ 0 | 1 ]
@@ -1758,20 +1759,78 @@ void CABACWriter::mvd_coding( const Mv &rMvd )
   {
     if( horAbs > 1 )
     {
-      exp_golomb_eqprob( horAbs - 2, 1 );
+      exp_golomb_eqprob_bins( binEnc, horAbs - 2, 1 );
     }
-    m_BinEncoder.encodeBinEP( (horMvd < 0) );
+    binEnc.encodeBinEP( (horMvd < 0) );
   }
   if( verAbs > 0 )
   {
     if( verAbs > 1 )
     {
-      exp_golomb_eqprob( verAbs - 2, 1 );
+      exp_golomb_eqprob_bins( binEnc, verAbs - 2, 1 );
     }
-    m_BinEncoder.encodeBinEP( (verMvd < 0) );
+    binEnc.encodeBinEP( (verMvd < 0) );
   }
 }
 
+#if ENABLE_FAST_RATE_ESTIMATION_CHECK
+template<class FastBins, class RefBins>
+void CABACWriter::checkFastRateEstimation( FastBins fastBins, RefBins refBins )
+{
+  // the reference run goes through the virtual BinEncIf interface on a copy of the estimator state
+  BitEstimator_Std refEstimator;
+  static_cast<Ctx&>( refEstimator ) = *m_BitEstimator;
+  refEstimator.resetBits();
+  refBins( static_cast<BinEncIf&>( refEstimator ) );
+
+  const uint64_t startBits = m_BitEstimator->getEstFracBits();
+  fastBins( *m_BitEstimator );
+
+  CHECK( m_BitEstimator->getEstFracBits() - startBits != refEstimator.getEstFracBits(), "Devirtualized rate estimation differs from the bin encoder interface" );
+
+  std::vector<uint16_t> fastStates, refStates;
+  m_BitEstimator->savePStates( fastStates );
+  refEstimator   .savePStates( refStates  );
+  CHECK( fastStates != refStates, "Devirtualized rate estimation left different context states" );
+}
+
+#endif
+#if JVET_K0357_AMVR
+void CABACWriter::mvd_coding( const Mv &rMvd, uint8_t imv )
+{
+#if ENABLE_FAST_RATE_ESTIMATION
+  if( m_BitEstimator )
+  {
+#if ENABLE_FAST_RATE_ESTIMATION_CHECK
+    checkFastRateEstimation( [&]( BitEstimator_Std& binEnc ) { mvd_coding_bins( binEnc, rMvd, imv ); },
+                             [&]( BinEncIf&         binEnc ) { mvd_coding_bins( binEnc, rMvd, imv ); } );
+#else
+    mvd_coding_bins( *m_BitEstimator, rMvd, imv );
+#endif
+    return;
+  }
+#endif
+  mvd_coding_bins( m_BinEncoder, rMvd, imv );
+}
+#else
+void CABACWriter::mvd_coding( const Mv &rMvd )
+{
+#if ENABLE_FAST_RATE_ESTIMATION
+  if( m_BitEstimator )
+  {
+#if ENABLE_FAST_RATE_ESTIMATION_CHECK
+    checkFastRateEstimation( [&]( BitEstimator_Std& binEnc ) { mvd_coding_bins( binEnc, rMvd ); },
+                             [&]( BinEncIf&         binEnc ) { mvd_coding_bins( binEnc, rMvd ); } );
+#else
+    mvd_coding_bins( *m_BitEstimator, rMvd );
+#endif
+    return;
+  }
+#endif
+  mvd_coding_bins( m_BinEncoder, rMvd );
+}
+#endif
+
 
 
 
@@ -2219,7 +2278,8 @@ void CABACWriter::explicit_rdpcm_mode( const TransformUnit& tu, ComponentID comp
 }
 
 
-void CABACWriter::last_sig_coeff( CoeffCodingContext& cctx )
+template<class BinEnc>
+void CABACWriter::last_sig_coeff_bins( BinEnc& binEnc, CoeffCodingContext& cctx )
 {
   unsigned blkPos = cctx.blockPos( cctx.scanPosLast() );
   unsigned posX, posY;
@@ -2242,26 +2302,26 @@ void CABACWriter::last_sig_coeff( CoeffCodingContext& cctx )
 
   for( CtxLast = 0; CtxLast < GroupIdxX; CtxLast++ )
   {
-    m_BinEncoder.encodeBin( 1, cctx.lastXCtxId( CtxLast ) );
+    binEnc.encodeBin( 1, cctx.lastXCtxId( CtxLast ) );
   }
   if( GroupIdxX < cctx.maxLastPosX() )
   {
-    m_BinEncoder.encodeBin( 0, cctx.lastXCtxId( CtxLast ) );
+    binEnc.encodeBin( 0, cctx.lastXCtxId( CtxLast ) );
   }
   for( CtxLast = 0; CtxLast < GroupIdxY; CtxLast++ )
   {
-    m_BinEncoder.encodeBin( 1, cctx.lastYCtxId( CtxLast ) );
+    binEnc.encodeBin( 1, cctx.lastYCtxId( CtxLast ) );
   }
   if( GroupIdxY < cctx.maxLastPosY() )
   {
-    m_BinEncoder.encodeBin( 0, cctx.lastYCtxId( CtxLast ) );
+    binEnc.encodeBin( 0, cctx.lastYCtxId( CtxLast ) );
   }
   if( GroupIdxX > 3 )
   {
     posX -= g_uiMinInGroup[ GroupIdxX ];
     for (int i = ( ( GroupIdxX - 2 ) >> 1 ) - 1 ; i >= 0; i-- )
     {
-      m_BinEncoder.encodeBinEP( ( posX >> i ) & 1 );
+      binEnc.encodeBinEP( ( posX >> i ) & 1 );
     }
   }
   if( GroupIdxY > 3 )
@@ -2269,15 +2329,34 @@ void CABACWriter::last_sig_coeff( CoeffCodingContext& cctx )
     posY -= g_uiMinInGroup[ GroupIdxY ];
     for ( int i = ( ( GroupIdxY - 2 ) >> 1 ) - 1 ; i >= 0; i-- )
     {
-      m_BinEncoder.encodeBinEP( ( posY >> i ) & 1 );
+      binEnc.encodeBinEP( ( posY >> i ) & 1 );
     }
   }
 }
 
+void CABACWriter::last_sig_coeff( CoeffCodingContext& cctx )
+{
+#if ENABLE_FAST_RATE_ESTIMATION
+  if( m_BitEstimator )
+  {
+#if ENABLE_FAST_RATE_ESTIMATION_CHECK
+    CoeffCodingContext refCctx = cctx;
+    checkFastRateEstimation( [&]( BitEstimator_Std& binEnc ) { last_sig_coeff_bins( binEnc, cctx    ); },
+                             [&]( BinEncIf&         binEnc ) { last_sig_coeff_bins( binEnc, refCctx ); } );
+#else
+    last_sig_coeff_bins( *m_BitEstimator, cctx );
+#endif
+    return;
+  }
+#endif
+  last_sig_coeff_bins( m_BinEncoder, cctx );
+}
+
 
 
 #if JVET_K0072
-void CABACWriter::residual_coding_subblock( CoeffCodingContext& cctx, const TCoeff* coeff, const int stateTransTable, int& state )
+template<class BinEnc>
+void CABACWriter::residual_coding_subblock_bins( BinEnc& binEnc, CoeffCodingContext& cctx, const TCoeff* coeff, const int stateTransTable, int& state )
 {
   //===== init =====
   const int   minSubPos   = cctx.minSubPos();
@@ -2290,11 +2369,11 @@ void CABACWriter::residual_coding_subblock( CoeffCodingContext& cctx, const TCoe
   {
     if( cctx.isSigGroup() )
     {
-      m_BinEncoder.encodeBin( 1, cctx.sigGroupCtxId() );
+      binEnc.encodeBin( 1, cctx.sigGroupCtxId() );
     }
     else
     {
-      m_BinEncoder.encodeBin( 0, cctx.sigGroupCtxId() );
+      binEnc.encodeBin( 0, cctx.sigGroupCtxId() );
       return;
     }
   }
@@ -2319,7 +2398,7 @@ void CABACWriter::residual_coding_subblock( CoeffCodingContext& cctx, const TCoe
     if( numNonZero || nextSigPos != inferSigPos )
     {
       const unsigned sigCtxId = cctx.sigCtxIdAbs( nextSigPos, coeff, state );
-      m_BinEncoder.encodeBin( sigFlag, sigCtxId );
+      binEnc.encodeBin( sigFlag, sigCtxId );
       DTRACE( g_trace_ctx, D_SYNTAX_RESI, "sig_bin() bin=%d ctx=%d\n", sigFlag, sigCtxId );
     }
 
@@ -2337,12 +2416,12 @@ void CABACWriter::residual_coding_subblock( CoeffCodingContext& cctx, const TCoe
       if( nextSigPos != cctx.scanPosLast() ) signPattern <<= 1;
       if( Coeff < 0 )                        signPattern++;
 
-      m_BinEncoder.encodeBin( remAbsLevel&1, cctx.parityCtxIdAbs(ctxOff) );
+      binEnc.encodeBin( remAbsLevel&1, cctx.parityCtxIdAbs(ctxOff) );
       DTRACE( g_trace_ctx, D_SYNTAX_RESI, "par_flag() bin=%d ctx=%d\n", remAbsLevel&1, cctx.parityCtxIdAbs(ctxOff) );
       remAbsLevel >>= 1;
 
       unsigned gt1 = !!remAbsLevel;
-      m_BinEncoder.encodeBin( gt1, cctx.greater1CtxIdAbs(ctxOff) );
+      binEnc.encodeBin( gt1, cctx.greater1CtxIdAbs(ctxOff) );
       DTRACE( g_trace_ctx, D_SYNTAX_RESI, "gt1_flag() bin=%d ctx=%d\n", gt1, cctx.greater1CtxIdAbs(ctxOff) );
       nextPass |= gt1;
     }
@@ -2362,7 +2441,7 @@ void CABACWriter::residual_coding_subblock( CoeffCodingContext& cctx, const TCoe
       {
         uint8_t& ctxOff = ctxOffset[ scanPos - minSubPos ];
         unsigned gt2    = ( absLevel > 4 );
-        m_BinEncoder.encodeBin( gt2, cctx.greater2CtxIdAbs(ctxOff) );
+        binEnc.encodeBin( gt2, cctx.greater2CtxIdAbs(ctxOff) );
         DTRACE( g_trace_ctx, D_SYNTAX_RESI, "gt2_flag() bin=%d ctx=%d\n", gt2, cctx.greater2CtxIdAbs(ctxOff) );
         nextPass |= gt2;
       }
@@ -2379,7 +2458,7 @@ void CABACWriter::residual_coding_subblock( CoeffCodingContext& cctx, const TCoe
       {
         unsigned rem     = ( absLevel - 5 ) >> 1;
         unsigned ricePar = cctx.GoRiceParAbs( scanPos, coeff );
-        m_BinEncoder.encodeRemAbsEP( rem, ricePar, cctx.extPrec(), cctx.maxLog2TrDRange() );
+        binEnc.encodeRemAbsEP( rem, ricePar, cctx.extPrec(), cctx.maxLog2TrDRange() );
         DTRACE( g_trace_ctx, D_SYNTAX_RESI, "rem_val() bin=%d ctx=%d\n", rem, ricePar );
       }
     }
@@ -2393,15 +2472,34 @@ void CABACWriter::residual_coding_subblock( CoeffCodingContext& cctx, const TCoe
     numSigns    --;
     signPattern >>= 1;
   }
-  m_BinEncoder.encodeBinsEP( signPattern, numSigns );
+  binEnc.encodeBinsEP( signPattern, numSigns );
 #else
-  m_BinEncoder.encodeBinsEP( signPattern, numNonZero );
+  binEnc.encodeBinsEP( signPattern, numNonZero );
 #endif
 #if JVET_K1000_SIMPLIFIED_EMT
   cctx.setEmtNumSigCoeff(numNonZero);
 #endif
 }
 
+void CABACWriter::residual_coding_subblock( CoeffCodingContext& cctx, const TCoeff* coeff, const int stateTransTable, int& state )
+{
+#if ENABLE_FAST_RATE_ESTIMATION
+  if( m_BitEstimator )
+  {
+#if ENABLE_FAST_RATE_ESTIMATION_CHECK
+    CoeffCodingContext refCctx  = cctx;
+    int                refState = state;
+    checkFastRateEstimation( [&]( BitEstimator_Std& binEnc ) { residual_coding_subblock_bins( binEnc, cctx,    coeff, stateTransTable, state    ); },
+                             [&]( BinEncIf&         binEnc ) { residual_coding_subblock_bins( binEnc, refCctx, coeff, stateTransTable, refState ); } );
+#else
+    residual_coding_subblock_bins( *m_BitEstimator, cctx, coeff, stateTransTable, state );
+#endif
+    return;
+  }
+#endif
+  residual_coding_subblock_bins( m_BinEncoder, cctx, coeff, stateTransTable, state );
+}
+
 #else
 
 void CABACWriter::residual_coding_subblock( CoeffCodingContext& cctx, const TCoeff* coeff )
@@ -2672,7 +2770,8 @@ void CABACWriter::unary_max_eqprob( unsigned symbol, unsigned maxSymbol )
 }
 
 
-void CABACWriter::exp_golomb_eqprob( unsigned symbol, unsigned count )
+template<class BinEnc>
+void CABACWriter::exp_golomb_eqprob_bins( BinEnc& binEnc, unsigned symbol, unsigned count )
 {
   unsigned bins    = 0;
   unsigned numBins = 0;
@@ -2689,7 +2788,24 @@ void CABACWriter::exp_golomb_eqprob( unsigned symbol, unsigned count )
   bins = (bins << count) | symbol;
   numBins += count;
   CHECK(!( numBins <= 32 ), "Unspecified error");
-  m_BinEncoder.encodeBinsEP( bins, numBins );
+  binEnc.encodeBinsEP( bins, numBins );
+}
+
+void CABACWriter::exp_golomb_eqprob( unsigned symbol, unsigned count )
+{
+#if ENABLE_FAST_RATE_ESTIMATION
+  if( m_BitEstimator )
+  {
+#if ENABLE_FAST_RATE_ESTIMATION_CHECK
+    checkFastRateEstimation( [&]( BitEstimator_Std& binEnc ) { exp_golomb_eqprob_bins( binEnc, symbol, count ); },
+                             [&]( BinEncIf&         binEnc ) { exp_golomb_eqprob_bins( binEnc, symbol, count ); } );
+#else
+    exp_golomb_eqprob_bins( *m_BitEstimator, symbol, count );
+#endif
+    return;
+  }
+#endif
+  exp_golomb_eqprob_bins( m_BinEncoder, symbol, count );
 }
 
 void CABACWriter::encode_sparse_dt( DecisionTree& dt, unsigned toCodeId )
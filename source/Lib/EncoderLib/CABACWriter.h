@@ -57,6 +57,9 @@ public:
   CABACWriter(BinEncIf& binEncoder)   : m_BinEncoder(binEncoder), m_Bitstream(0) { m_TestCtx = m_BinEncoder.getCtx(); m_EncCu = NULL; }
 #else
   CABACWriter( BinEncIf& binEncoder ) : m_BinEncoder( binEncoder ), m_Bitstream( 0 ) { m_TestCtx = m_BinEncoder.getCtx(); }
+#endif
+#if ENABLE_FAST_RATE_ESTIMATION
+  CABACWriter( BitEstimator_Std& binEstimator ) : CABACWriter( static_cast<BinEncIf&>( binEstimator ) ) { m_BitEstimator = &binEstimator; }
 #endif
   virtual ~CABACWriter() {}
 
@@ -196,6 +199,26 @@ private:
   void        unary_max_symbol          ( unsigned symbol, unsigned ctxId0, unsigned ctxIdN, unsigned maxSymbol );
   void        unary_max_eqprob          ( unsigned symbol,                                   unsigned maxSymbol );
   void        exp_golomb_eqprob         ( unsigned symbol, unsigned count );
+
+  // binarizations shared by the coding and the estimation path, instantiated for the devirtualized bit estimator
+  template<class BinEnc>
+  void        exp_golomb_eqprob_bins    ( BinEnc& binEnc, unsigned symbol, unsigned count );
+  template<class BinEnc>
+#if JVET_K0357_AMVR
+  void        mvd_coding_bins           ( BinEnc& binEnc, const Mv &rMvd, uint8_t imv );
+#else
+  void        mvd_coding_bins           ( BinEnc& binEnc, const Mv &rMvd );
+#endif
+  template<class BinEnc>
+  void        last_sig_coeff_bins       ( BinEnc& binEnc, CoeffCodingContext& cctx );
+#if JVET_K0072
+  template<class BinEnc>
+  void        residual_coding_subblock_bins( BinEnc& binEnc, CoeffCodingContext& cctx, const TCoeff* coeff, const int stateTransTable, int& state );
+#endif
+#if ENABLE_FAST_RATE_ESTIMATION_CHECK
+  template<class FastBins, class RefBins>
+  void        checkFastRateEstimation   ( FastBins fastBins, RefBins refBins );
+#endif
   void        encode_sparse_dt          ( DecisionTree& dt, unsigned toCodeId );
 
   // statistic
@@ -203,6 +226,9 @@ private:
 
 private:
   BinEncIf&         m_BinEncoder;
+#if ENABLE_FAST_RATE_ESTIMATION
+  BitEstimator_Std* m_BitEstimator = nullptr;  ///< set when m_BinEncoder is the standard bit estimator
+#endif
   OutputBitstream*  m_Bitstream;
   Ctx               m_TestCtx;
 #if JVET_K0346
@@ -39,6 +39,7 @@
 #if JVET_K0371_ALF
 #include "CommonLib/Picture.h"
 #include "CommonLib/CodingStructure.h"
+#include "CommonLib/ToolTimer.h"
 
 #define AlfCtx(c) SubCtx( Ctx::ctbAlfFlag, c )
 
@@ -220,6 +221,8 @@ void EncAdaptiveLoopFilter::initCABACEstimator( CABACEncoder* cabacEncoder, CtxC
 
 void EncAdaptiveLoopFilter::ALFProcess( CodingStructure& cs, const double *lambdas, AlfSliceParam& alfSliceParam )
 {
+  TOOL_TIMER( TOOL_ALF );
+
   // set available filter shapes
   alfSliceParam.filterShapes = m_filterShapes;
 
@@ -642,8 +645,8 @@ double EncAdaptiveLoopFilter::mergeFiltersAndCost( AlfSliceParam& alfSliceParam,
 {
   int numFiltersBest = 0;
   int numFilters = MAX_NUM_ALF_CLASSES;
-  static bool codedVarBins[MAX_NUM_ALF_CLASSES];
-  static double errorForce0CoeffTab[MAX_NUM_ALF_CLASSES][2];
+  bool codedVarBins[MAX_NUM_ALF_CLASSES];
+  double errorForce0CoeffTab[MAX_NUM_ALF_CLASSES][2];
 
   double cost, cost0, dist, distForce0, costMin = MAX_DOUBLE;
   int predMode = 0, bestPredMode = 0, coeffBits, coeffBitsForce0;
@@ -922,7 +925,7 @@ int EncAdaptiveLoopFilter::lengthFilterCoeffs( AlfFilterShape& alfShape, const i
 
 double EncAdaptiveLoopFilter::getDistForce0( AlfFilterShape& alfShape, const int numFilters, double errorTabForce0Coeff[MAX_NUM_ALF_CLASSES][2], bool* codedVarBins )
 {
-  static int bitsVarBin[MAX_NUM_ALF_CLASSES];
+  int bitsVarBin[MAX_NUM_ALF_CLASSES];
 
   memset( m_bitsCoeffScan, 0, sizeof( m_bitsCoeffScan ) );
   for( int ind = 0; ind < numFilters; ++ind )
@@ -1077,8 +1080,8 @@ double EncAdaptiveLoopFilter::deriveFilterCoeffs( AlfCovariance* cov, AlfCovaria
 double EncAdaptiveLoopFilter::deriveCoeffQuant( int *filterCoeffQuant, double **E, double *y, const int numCoeff, std::vector<int>& weights, const int bitDepth, const bool bChroma )
 {
   const int factor = 1 << ( bitDepth - 1 );
-  static int filterCoeffQuantMod[MAX_NUM_ALF_LUMA_COEFF];
-  static double filterCoeff[MAX_NUM_ALF_LUMA_COEFF];
+  int filterCoeffQuantMod[MAX_NUM_ALF_LUMA_COEFF];
+  double filterCoeff[MAX_NUM_ALF_LUMA_COEFF];
 
   gnsSolveByChol( E, y, filterCoeff, numCoeff );
   roundFiltCoeff( filterCoeffQuant, filterCoeff, numCoeff, factor );
@@ -1184,9 +1187,9 @@ void EncAdaptiveLoopFilter::roundFiltCoeff( int *filterCoeffQuant, double *filte
 
 void EncAdaptiveLoopFilter::mergeClasses( AlfCovariance* cov, AlfCovariance* covMerged, const int numClasses, short filterIndices[MAX_NUM_ALF_CLASSES][MAX_NUM_ALF_CLASSES] )
 {
-  static bool availableClass[MAX_NUM_ALF_CLASSES];
-  static uint8_t indexList[MAX_NUM_ALF_CLASSES];
-  static uint8_t indexListTemp[MAX_NUM_ALF_CLASSES];
+  bool availableClass[MAX_NUM_ALF_CLASSES];
+  uint8_t indexList[MAX_NUM_ALF_CLASSES];
+  uint8_t indexListTemp[MAX_NUM_ALF_CLASSES];
   int numRemaining = numClasses;
 
   memset( filterIndices, 0, sizeof( short ) * MAX_NUM_ALF_CLASSES * MAX_NUM_ALF_CLASSES );
@@ -1393,7 +1396,7 @@ void EncAdaptiveLoopFilter::deriveStatsForFiltering( PelUnitBuf& orgYuv, PelUnit
 
 void EncAdaptiveLoopFilter::getBlkStats( AlfCovariance* alfCovariace, const AlfFilterShape& shape, AlfClassifier** classifier, Pel* org, const int orgStride, Pel* rec, const int recStride, const CompArea& area )
 {
-  static int ELocal[MAX_NUM_ALF_LUMA_COEFF];
+  int ELocal[MAX_NUM_ALF_LUMA_COEFF];
 
   int transposeIdx = 0;
   int classIdx = 0;
@@ -1518,7 +1521,7 @@ void EncAdaptiveLoopFilter::calcCovariance( int *ELocal, const Pel *rec, const i
 
 double EncAdaptiveLoopFilter::calculateError( AlfCovariance& cov )
 {
-  static double c[MAX_NUM_ALF_COEFF];
+  double c[MAX_NUM_ALF_COEFF];
 
   gnsSolveByChol( cov.E, cov.y, c, cov.numCoeff );
 
@@ -1542,7 +1545,7 @@ double EncAdaptiveLoopFilter::calculateError( AlfCovariance& cov )
 //Find filter coeff related
 int EncAdaptiveLoopFilter::gnsCholeskyDec( double **inpMatr, double outMatr[MAX_NUM_ALF_COEFF][MAX_NUM_ALF_COEFF], int numEq )
 {
-  static double invDiag[MAX_NUM_ALF_COEFF];  /* Vector of the inverse of diagonal entries of outMatr */
+  double invDiag[MAX_NUM_ALF_COEFF];  /* Vector of the inverse of diagonal entries of outMatr */
 
   for( int i = 0; i < numEq; i++ )
   {
@@ -1616,8 +1619,8 @@ void EncAdaptiveLoopFilter::gnsBacksubstitution( double R[MAX_NUM_ALF_COEFF][MAX
 
 int EncAdaptiveLoopFilter::gnsSolveByChol( double **LHS, double *rhs, double *x, int numEq )
 {
-  static double aux[MAX_NUM_ALF_COEFF];     /* Auxiliary vector */
-  static double U[MAX_NUM_ALF_COEFF][MAX_NUM_ALF_COEFF];    /* Upper triangular Cholesky factor of LHS */
+  double aux[MAX_NUM_ALF_COEFF];     /* Auxiliary vector */
+  double U[MAX_NUM_ALF_COEFF][MAX_NUM_ALF_COEFF];    /* Upper triangular Cholesky factor of LHS */
   int res = 1;  // Signal that Cholesky factorization is successfully performed
 
                 /* The equation to be solved is LHSx = rhs */
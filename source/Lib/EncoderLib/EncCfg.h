@@ -203,6 +203,8 @@ protected:
 #if JVET_K0337_AFFINE_6PARA
   int       m_AffineType;
 #endif
+  bool      m_AffineAdaptiveSubblock;
+  int       m_FastAffineModel;
 #endif
 #if JVET_K0346 || JVET_K_AFFINE
   bool      m_highPrecMv;
@@ -326,7 +328,9 @@ protected:
 
   bool      m_bUseConstrainedIntraPred;
   bool      m_bFastUDIUseMPMEnabled;
+  int       m_fastIntraModeDecision;
   bool      m_bFastMEForGenBLowDelayEnabled;
+  bool      m_MEPreSearch;
   bool      m_bUseBLambdaForNonKeyLowDelayPictures;
   bool      m_usePCM;
   int       m_PCMBitDepth[MAX_NUM_CHANNEL_TYPE];
@@ -447,6 +451,7 @@ protected:
   bool      m_RCUseLCUSeparateModel;
   int       m_RCInitialQP;
   bool      m_RCForceIntraQP;
+  bool      m_RCLookahead;
 #if U0132_TARGET_BITS_SATURATION
   bool      m_RCCpbSaturationEnabled;
   uint32_t      m_RCCpbSize;
@@ -516,6 +521,7 @@ protected:
   bool        m_forceDecodeBitstream1;                        ///< guess what it means
   int         m_switchPOC;                                    ///< dbg poc.
   int         m_switchDQP;                                    ///< dqp applied to  switchPOC and subsequent pictures.
+  mutable int m_appliedSwitchDQQ;                             ///< dqp applied from switchPOC on
   int         m_fastForwardToPOC;                             ///<
   bool        m_stopAfterFFtoPOC;                             ///<
   bool        m_bs2ModPOCAndType;
@@ -545,6 +551,7 @@ public:
   {
     m_PCMBitDepth[CHANNEL_TYPE_LUMA]=8;
     m_PCMBitDepth[CHANNEL_TYPE_CHROMA]=8;
+    m_appliedSwitchDQQ = 0;
   }
 
   virtual ~EncCfg()
@@ -638,6 +645,10 @@ public:
   void      setAffineType( int b )                          { m_AffineType = b; }
   int       getAffineType()                            const { return m_AffineType; }
 #endif
+  void      setAffineAdaptiveSubblock       ( bool b )       { m_AffineAdaptiveSubblock = b; }
+  bool      getAffineAdaptiveSubblock       ()         const { return m_AffineAdaptiveSubblock; }
+  void      setFastAffineModel              ( int i )        { m_FastAffineModel = i; }
+  int       getFastAffineModel              ()         const { return m_FastAffineModel; }
 #endif
 #if JVET_K0346 || JVET_K_AFFINE
   void      setHighPrecisionMv(bool b) { m_highPrecMv = b; }
@@ -870,7 +881,9 @@ public:
   void      setUseEarlySkipDetection        ( bool  b )     { m_useEarlySkipDetection = b; }
   void      setUseConstrainedIntraPred      ( bool  b )     { m_bUseConstrainedIntraPred = b; }
   void      setFastUDIUseMPMEnabled         ( bool  b )     { m_bFastUDIUseMPMEnabled = b; }
+  void      setFastIntraModeDecision        ( int   i )     { m_fastIntraModeDecision = i; }
   void      setFastMEForGenBLowDelayEnabled ( bool  b )     { m_bFastMEForGenBLowDelayEnabled = b; }
+  void      setUseMEPreSearch               ( bool  b )     { m_MEPreSearch = b; }
   void      setUseBLambdaForNonKeyLowDelayPictures ( bool b ) { m_bUseBLambdaForNonKeyLowDelayPictures = b; }
 
   void      setPCMInputBitDepthFlag         ( bool  b )     { m_bPCMInputBitDepthFlag = b; }
@@ -898,7 +911,9 @@ public:
   bool      getUseEarlySkipDetection        () const{ return m_useEarlySkipDetection; }
   bool      getUseConstrainedIntraPred      ()      { return m_bUseConstrainedIntraPred; }
   bool      getFastUDIUseMPMEnabled         ()      { return m_bFastUDIUseMPMEnabled; }
+  int       getFastIntraModeDecision        ()      { return m_fastIntraModeDecision; }
   bool      getFastMEForGenBLowDelayEnabled ()      { return m_bFastMEForGenBLowDelayEnabled; }
+  bool      getUseMEPreSearch               ()      { return m_MEPreSearch; }
   bool      getUseBLambdaForNonKeyLowDelayPictures () { return m_bUseBLambdaForNonKeyLowDelayPictures; }
   bool      getPCMInputBitDepthFlag         ()      { return m_bPCMInputBitDepthFlag;   }
   bool      getPCMFilterDisableFlag         ()      { return m_bPCMFilterDisableFlag;   }
@@ -1167,6 +1182,8 @@ public:
   void         setInitialQP           ( int QP )                     { m_RCInitialQP = QP;             }
   bool         getForceIntraQP        ()                             { return m_RCForceIntraQP;        }
   void         setForceIntraQP        ( bool b )                     { m_RCForceIntraQP = b;           }
+  bool         getUseRCLookahead      ()                             { return m_RCLookahead;           }
+  void         setUseRCLookahead      ( bool b )                     { m_RCLookahead = b;              }
 #if U0132_TARGET_BITS_SATURATION
   bool         getCpbSaturationEnabled()                             { return m_RCCpbSaturationEnabled;}
   void         setCpbSaturationEnabled( bool b )                     { m_RCCpbSaturationEnabled = b;   }
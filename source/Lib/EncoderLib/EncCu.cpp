@@ -653,7 +653,10 @@ void EncCu::xCompressCU( CodingStructure *&tempCS, CodingStructure *&bestCS, Par
 
 		  // 8 parameter perspective    κ
 		  bool isPerspt = true;
-		  xCheckRDCostInter(tempCS, bestCS, partitioner, currTestMode, isPerspt);
+		  if( m_modeCtrl->tryAffineModel( *tempCS, partitioner, isPerspt ) )
+		  {
+		    xCheckRDCostInter(tempCS, bestCS, partitioner, currTestMode, isPerspt);
+		  }
       }
 
     }
@@ -1042,7 +1045,11 @@ void EncCu::xCheckModeSplit(CodingStructure *&tempCS, CodingStructure *&bestCS,
 #endif
   m_CurrCtx++;
 
-  tempCS->getRecoBuf().fill( 0 );
+  if( !tempCS->picture->Y().contains( tempCS->area.Y() ) )
+  {
+    // the sub-CUs only fill the part inside the picture, within the picture every sample is overwritten on promotion
+    tempCS->getRecoBuf().fill( 0 );
+  }
 
   do
   {
@@ -1851,14 +1858,34 @@ void EncCu::xCheckRDCostInter( CodingStructure *&tempCS, CodingStructure *&bestC
 
   Mv bestCSMv[2][4];
   int bestCSRefIdx[2] = { -1, -1 };
+  // only a translational PU with a single motion has its MV in every motion buffer entry,
+  // sub-PU merge candidates and intra CUs are read from the motion buffer corners
+  const bool bestUniformMv = CU::isInter( Bestcu ) && ( !Bestpu.mergeFlag || Bestpu.mergeType == MRG_TYPE_DEFAULT_N );
   const CMotionBuf &Bestmb = Bestpu.getMotionBuf();
 
   for (int refList = 0; refList < 2; refList++)
   {
-	  bestCSMv[refList][0] = Bestmb.at(0, 0).mv[refList];
-	  bestCSMv[refList][1] = Bestmb.at(Bestmb.width - 1, 0).mv[refList];
-	  bestCSMv[refList][2] = Bestmb.at(0, Bestmb.height - 1).mv[refList];
-	  bestCSMv[refList][3] = Bestmb.at(Bestmb.width - 1, Bestmb.height - 1).mv[refList];
+	  if (Bestcu.affine)
+	  {
+		  for (int verIdx = 0; verIdx < 4; verIdx++)
+		  {
+			  bestCSMv[refList][verIdx] = Bestpu.mvAffi[refList][verIdx];
+		  }
+	  }
+	  else if (bestUniformMv)
+	  {
+		  for (int verIdx = 0; verIdx < 4; verIdx++)
+		  {
+			  bestCSMv[refList][verIdx] = Bestpu.mv[refList];
+		  }
+	  }
+	  else
+	  {
+		  bestCSMv[refList][0] = Bestmb.at(0, 0).mv[refList];
+		  bestCSMv[refList][1] = Bestmb.at(Bestmb.width - 1, 0).mv[refList];
+		  bestCSMv[refList][2] = Bestmb.at(0, Bestmb.height - 1).mv[refList];
+		  bestCSMv[refList][3] = Bestmb.at(Bestmb.width - 1, Bestmb.height - 1).mv[refList];
+	  }
   }
   bestCSRefIdx[0] = Bestpu.refIdx[0];
   bestCSRefIdx[1] = Bestpu.refIdx[1];
@@ -46,6 +46,7 @@
 #include "CommonLib/SEI.h"
 #include "CommonLib/NAL.h"
 #include "NALwrite.h"
+#include "AQp.h"
 
 #include <math.h>
 #include <deque>
@@ -110,11 +111,13 @@ EncGOP::EncGOP()
 #endif
 
   m_bInitAMaxBT         = true;
+  m_bHitFastForwardPOC  = false;
+  m_switchPPSId         = 0;
 }
 
 EncGOP::~EncGOP()
 {
-  if( !m_pcCfg->getDecodeBitstream(0).empty() || !m_pcCfg->getDecodeBitstream(1).empty() )
+  if( m_pcCfg && ( !m_pcCfg->getDecodeBitstream(0).empty() || !m_pcCfg->getDecodeBitstream(1).empty() ) )
   {
     // reset potential decoder resources
     tryDecodePicture( NULL, 0, std::string("") );
@@ -1172,7 +1175,7 @@ bool isPicEncoded( int targetPoc, int curPoc, int curTLayer, int gopSize, int in
   return curTLayer <= tarTL && curId == 0;
 }
 
-void trySkipOrDecodePicture( bool& decPic, bool& encPic, const EncCfg& cfg, Picture* pcPic )
+void trySkipOrDecodePicture( bool& decPic, bool& encPic, bool& hitFastForwardPOC, const EncCfg& cfg, Picture* pcPic )
 {
   // check if we should decode a leading bitstream
   if( !cfg.getDecodeBitstream( 0 ).empty() )
@@ -1261,18 +1264,17 @@ void trySkipOrDecodePicture( bool& decPic, bool& encPic, const EncCfg& cfg, Pict
   }
 
   // this is the forward to poc section
-  static bool bHitFastForwardPOC = false; /* TODO: MT */
-  if( bHitFastForwardPOC || isPicEncoded( cfg.getFastForwardToPOC(), pcPic->getPOC(), pcPic->layer, cfg.getGOPSize(), cfg.getIntraPeriod() ) )
+  if( hitFastForwardPOC || isPicEncoded( cfg.getFastForwardToPOC(), pcPic->getPOC(), pcPic->layer, cfg.getGOPSize(), cfg.getIntraPeriod() ) )
   {
-    bHitFastForwardPOC |= cfg.getFastForwardToPOC() == pcPic->getPOC(); // once we hit the poc we continue encoding
+    hitFastForwardPOC |= cfg.getFastForwardToPOC() == pcPic->getPOC(); // once we hit the poc we continue encoding
 
-    if( bHitFastForwardPOC && cfg.getStopAfterFFtoPOC() && cfg.getFastForwardToPOC() != pcPic->getPOC() )
+    if( hitFastForwardPOC && cfg.getStopAfterFFtoPOC() && cfg.getFastForwardToPOC() != pcPic->getPOC() )
     {
       return;
     }
 
     //except if FastForwardtoPOC is meant to be a SwitchPOC in thist case drop all preceding pictures
-    if( bHitFastForwardPOC && ( cfg.getSwitchPOC() == cfg.getFastForwardToPOC() ) && ( cfg.getFastForwardToPOC() > pcPic->getPOC() ) )
+    if( hitFastForwardPOC && ( cfg.getSwitchPOC() == cfg.getFastForwardToPOC() ) && ( cfg.getFastForwardToPOC() > pcPic->getPOC() ) )
     {
       return;
     }
@@ -1374,12 +1376,11 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     // th this is a hot fix for the choma qp control
     if( m_pcEncLib->getWCGChromaQPControl().isEnabled() && m_pcEncLib->getSwitchPOC() != -1 )
     {
-      static int usePPS = 0; /* TODO: MT */
       if( pocCurr == m_pcEncLib->getSwitchPOC() )
       {
-        usePPS = 1;
+        m_switchPPSId = 1;
       }
-      const PPS *pPPS = m_pcEncLib->getPPS(usePPS);
+      const PPS *pPPS = m_pcEncLib->getPPS(m_switchPPSId);
       // replace the pps with a more appropriated one
       pcPic->cs->pps = pPPS;
     }
@@ -1706,6 +1707,12 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
       m_pcSliceEncoder->setSearchRange(pcSlice);
     }
 
+    // hierarchical motion pre-search, also run for intra slices to drop the field of a previous use of the picture
+    if (m_pcCfg->getUseMEPreSearch())
+    {
+      MEPreanalyzer::preanalyze(pcPic, *pcSlice);
+    }
+
     bool bGPBcheck=false;
     if ( pcSlice->getSliceType() == B_SLICE)
     {
@@ -1748,7 +1755,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
       {
         frameLevel = 0;
       }
-      m_pcRateCtrl->initRCPic( frameLevel );
+      m_pcRateCtrl->initRCPic( frameLevel, pcPic->m_lookaheadCostCtu );
       estimatedBits = m_pcRateCtrl->getRCPic()->getTargetBits();
 
 #if U0132_TARGET_BITS_SATURATION
@@ -1902,7 +1909,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     bool decPic = false;
     bool encPic = false;
     // test if we can skip the picture entirely or decode instead of encoding
-    trySkipOrDecodePicture( decPic, encPic, *m_pcCfg, pcPic );
+    trySkipOrDecodePicture( decPic, encPic, m_bHitFastForwardPOC, *m_pcCfg, pcPic );
 
     pcPic->cs->slice = pcSlice; // please keep this
     if (pcSlice->getPPS()->getSliceChromaQpFlag() && CS::isDualITree(*pcSlice->getPic()->cs))
@@ -2009,6 +2016,9 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
       }
 
       m_pcLoopFilter->loopFilterPic( cs );
+#if ENABLE_COMPRESSED_COL_MOTION
+      cs.compressColMotion();
+#endif
 
       DTRACE_UPDATE( g_trace_ctx, ( std::make_pair( "final", 1 ) ) );
 
@@ -3002,6 +3012,7 @@ void EncGOP::xCalculateAddPSNR( Picture* pcPic, PelUnitBuf cPicD, const AccessUn
     }
 #endif
     msg( NOTICE, " [ET %5.0f ]", dEncTime );
+    msg( NOTICE, " [LF %6.3f ]", m_pcLoopFilter->getPicProcessingTime() );
 
     // msg( SOME, " [WP %d]", pcSlice->getUseWeightedPrediction());
 
@@ -119,6 +119,8 @@ private:
   bool                    m_bFirst;
   int                     m_iLastRecoveryPicPOC;
   int                     m_lastRasPoc;
+  bool                    m_bHitFastForwardPOC;                 ///< fast forward POC reached, encode from here on
+  int                     m_switchPPSId;                        ///< PPS used from the chroma QP control switching POC on
 
   //  Access channel
   EncLib*                 m_pcEncLib;
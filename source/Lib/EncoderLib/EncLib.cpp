@@ -509,7 +509,7 @@ void EncLib::encode( bool flush, PelStorage* pcPicYuvOrg, PelStorage* cPicYuvTru
 
       pcPicCurr->M_BUFS( 0, PIC_ORIGINAL ).swap( *pcPicYuvOrg );
 
-      pcPicCurr->finalInit( *pSPS, *pPPS );
+      pcPicCurr->finalInit( *pSPS, *pPPS, m_unitCache );
     }
 
     pcPicCurr->poc = m_iPOCLast;
@@ -519,6 +519,26 @@ void EncLib::encode( bool flush, PelStorage* pcPicYuvOrg, PelStorage* cPicYuvTru
     {
       AQpPreanalyzer::preanalyze( pcPicCurr );
     }
+
+    // downsampled source for the lookahead and the motion pre-search
+    if ( ( m_RCEnableRateControl && m_RCLookahead ) || m_MEPreSearch )
+    {
+      pcPicCurr->createOrigPyramid();
+    }
+
+    // lookahead complexity for rate control, analysed against the previous source picture
+    pcPicCurr->m_lookaheadCostCtu.clear();
+    if ( m_RCEnableRateControl && m_RCLookahead )
+    {
+      for ( const Picture* pcPicPrev : m_cListPic )
+      {
+        if ( pcPicPrev->poc == pcPicCurr->poc - 1 && pcPicPrev != pcPicCurr )
+        {
+          RCPreanalyzer::preanalyze( pcPicCurr, pcPicPrev );
+          break;
+        }
+      }
+    }
   }
 
   if ((m_iNumPicRcvd == 0) || (!flush && (m_iPOCLast != 0) && (m_iNumPicRcvd != m_iGOPSize) && (m_iGOPSize != 0)))
@@ -529,7 +549,30 @@ void EncLib::encode( bool flush, PelStorage* pcPicYuvOrg, PelStorage* cPicYuvTru
 
   if ( m_RCEnableRateControl )
   {
-    m_cRateCtrl.initRCGOP( m_iNumPicRcvd );
+    // lookahead complexity of the pictures of this GOP in coding order (0 if not analysed), the lookahead
+    // window is limited to the pictures buffered for the GOP
+    std::vector<double> picLookaheadCost;
+    if ( m_RCLookahead )
+    {
+      for ( int iGOPid = 0; iGOPid < ( m_iPOCLast == 0 ? 1 : m_iGOPSize ); iGOPid++ )
+      {
+        const int poc = m_iPOCLast == 0 ? 0 : m_iPOCLast - m_iNumPicRcvd + getGOPEntry( iGOPid ).m_POC;
+        if ( poc >= m_framesToBeEncoded )
+        {
+          continue;
+        }
+        double cost = 0.0;
+        for ( const Picture* pcPic : m_cListPic )
+        {
+          if ( pcPic->poc == poc && !pcPic->m_lookaheadCostCtu.empty() )
+          {
+            cost = RCPreanalyzer::getPicCost( pcPic );
+          }
+        }
+        picLookaheadCost.push_back( cost );
+      }
+    }
+    m_cRateCtrl.initRCGOP( m_iNumPicRcvd, picLookaheadCost );
   }
 
   // compress GOP
@@ -602,7 +645,7 @@ void EncLib::encode( bool flush, PelStorage* pcPicYuvOrg, PelStorage* pcPicYuvTr
         const PPS *pPPS=(ppsID<0) ? m_ppsMap.getFirstPS() : m_ppsMap.getPS(ppsID);
         const SPS *pSPS=m_spsMap.getPS(pPPS->getSPSId());
 
-        pcField->finalInit( *pSPS, *pPPS );
+        pcField->finalInit( *pSPS, *pPPS, m_unitCache );
       }
 
       pcField->poc = m_iPOCLast;
@@ -802,6 +845,7 @@ void EncLib::xInitSPS(SPS &sps)
 #if JVET_K0337_AFFINE_6PARA
   sps.getSpsNext().setUseAffineType         ( m_AffineType );
 #endif
+  sps.getSpsNext().setUseAffineAdaptiveSubblock( m_Affine && m_AffineAdaptiveSubblock );
 #endif
 #if JVET_K0346 && !JVET_K_AFFINE
   sps.getSpsNext().setUseHighPrecMv(m_highPrecMv);
@@ -1667,12 +1711,11 @@ int EncCfg::getQPForPicture(const uint32_t gopIndex, const Slice *pSlice) const
     qp = getBaseQP();
 
     // switch at specific qp and keep this qp offset
-    static int appliedSwitchDQQ = 0; /* TODO: MT */
     if( pSlice->getPOC() == getSwitchPOC() )
     {
-      appliedSwitchDQQ = getSwitchDQP();
+      m_appliedSwitchDQQ = getSwitchDQP();
     }
-    qp += appliedSwitchDQQ;
+    qp += m_appliedSwitchDQQ;
 
 #if QP_SWITCHING_FOR_PARALLEL
     const int* pdQPs = getdQPs();
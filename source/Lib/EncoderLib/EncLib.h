@@ -74,6 +74,7 @@ private:
   int                       m_iPOCLast;                           ///< time index (POC)
   int                       m_iNumPicRcvd;                        ///< number of received pictures
   uint32_t                      m_uiNumAllPicCoded;                   ///< number of coded pictures
+  XUCache                   m_unitCache;                          ///< unit cache of the picture coding structures
   PicList                   m_cListPic;                           ///< dynamic list of pictures
 
   // encoder search
@@ -1820,6 +1820,8 @@ bool EncModeCtrlMTnoRQT::tryMode( const EncTestMode& encTestmode, const CodingSt
 #else
           relatedCU.isSkip    = bestCU->skip;
 #endif
+          relatedCU.isAffine |= bestCU->affine && bestCU->affineType != AFFINEMODEL_8PARAM;
+          relatedCU.isPersp  |= bestCU->affine && bestCU->affineType == AFFINEMODEL_8PARAM;
         }
         else if( CU::isIntra( *bestCU ) )
         {
@@ -1993,6 +1995,62 @@ bool EncModeCtrlMTnoRQT::useModeResult( const EncTestMode& encTestmode, CodingSt
   }
 }
 
+/** decide if the affine (perspective == false) or the perspective ME is tested for the current CU
+ *
+ * The decision uses the motion model chosen for the parent CU and for earlier codings of the same area:
+ * level 1 skips the perspective ME if the parent tested and rejected it, level 2 skips it whenever the parent
+ * was coded inter without the perspective model and skips the affine ME if the parent tested and rejected it.
+ */
+bool EncModeCtrlMTnoRQT::tryAffineModel( const CodingStructure &cs, Partitioner& partitioner, const bool perspective )
+{
+  const int level = m_pcEncCfg->getFastAffineModel();
+
+  if( level == 0 )
+  {
+    return true;
+  }
+
+  // the perspective pass repeats the translational ME, it is only useful if the block can be coded affine
+  if( perspective && ( cs.area.lwidth() <= 8 || cs.area.lheight() <= 8 || !cs.sps->getSpsNext().getUseAffine() ) )
+  {
+    return false;
+  }
+
+  CodedCUInfo &relatedCU = getBlkInfo( partitioner.currArea() );
+  const PartitioningStack &partStack = partitioner.getPartStack();
+
+  if( partStack.size() > 1 )
+  {
+    const PartLevel   &parentLevel = partStack[partStack.size() - 2];
+    const CodedCUInfo &parentCU    = getBlkInfo( parentLevel.parts[parentLevel.idx] );
+
+    if( parentCU.isInter && !parentCU.isPersp && !relatedCU.isPersp )
+    {
+      if( perspective && ( parentCU.triedPersp || level >= 2 ) )
+      {
+        return false;
+      }
+      if( !perspective && level >= 2 && parentCU.triedAffine && !parentCU.isAffine && !relatedCU.isAffine )
+      {
+        return false;
+      }
+    }
+  }
+
+  if( perspective )
+  {
+    relatedCU.triedPersp  = true;
+  }
+  else
+  {
+    relatedCU.triedAffine = true;
+  }
+#if ENABLE_SPLIT_PARALLELISM
+  touch( partitioner.currArea() );
+#endif
+  return true;
+}
+
 #if ENABLE_SPLIT_PARALLELISM
 void EncModeCtrlMTnoRQT::copyState( const EncModeCtrl& other, const UnitArea& area )
 {
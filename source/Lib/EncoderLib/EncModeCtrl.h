@@ -282,6 +282,7 @@ protected:
 public:
 
   virtual bool useModeResult        ( const EncTestMode& encTestmode, CodingStructure*& tempCS,  Partitioner& partitioner ) = 0;
+  virtual bool tryAffineModel       ( const CodingStructure &cs, Partitioner& partitioner, const bool perspective )               { return true;  }
 #if ENABLE_SPLIT_PARALLELISM
   virtual void copyState            ( const EncModeCtrl& other, const UnitArea& area );
   virtual int  getNumParallelJobs   ( const CodingStructure &cs, Partitioner& partitioner )                                 const { return 1;     }
@@ -382,6 +383,10 @@ struct CodedCUInfo
   bool isInter;
   bool isIntra;
   bool isSkip;
+  bool isAffine;       ///< chosen with the 4/6-parameter affine model
+  bool isPersp;        ///< chosen with the 8-parameter perspective model
+  bool triedAffine;    ///< the affine ME was tested
+  bool triedPersp;     ///< the perspective ME was tested
 
   bool validMv[NUM_REF_PIC_LIST_01][MAX_STORED_CU_INFO_REFS];
   Mv   saveMv [NUM_REF_PIC_LIST_01][MAX_STORED_CU_INFO_REFS];
@@ -541,6 +546,7 @@ public:
 
   virtual bool tryMode            ( const EncTestMode& encTestmode, const CodingStructure &cs, Partitioner& partitioner );
   virtual bool useModeResult      ( const EncTestMode& encTestmode, CodingStructure*& tempCS,  Partitioner& partitioner );
+  virtual bool tryAffineModel     ( const CodingStructure &cs, Partitioner& partitioner, const bool perspective );
 
 #if ENABLE_SPLIT_PARALLELISM
   virtual void copyState          ( const EncModeCtrl& other, const UnitArea& area );
@@ -41,6 +41,7 @@
 #include "CommonLib/dtrace_codingstruct.h"
 #include "CommonLib/dtrace_buffer.h"
 #include "CommonLib/CodingStructure.h"
+#include "CommonLib/ToolTimer.h"
 
 #include <string.h>
 #include <stdlib.h>
@@ -216,6 +217,8 @@ void EncSampleAdaptiveOffset::SAOProcess(CodingStructure& cs, bool* sliceEnabled
 void EncSampleAdaptiveOffset::SAOProcess(CodingStructure& cs, bool* sliceEnabled, const double *lambdas, const bool bTestSAODisableAtPictureLevel, const double saoEncodingRate, const double saoEncodingRateChroma, bool isPreDBFSamplesUsed )
 #endif
 {
+  TOOL_TIMER( TOOL_SAO );
+
   PelUnitBuf org = cs.getOrgBuf();
   PelUnitBuf res = cs.getRecoBuf();
   PelUnitBuf src = m_tempBuf;
@@ -45,6 +45,7 @@
 #include "CommonLib/UnitTools.h"
 #include "CommonLib/dtrace_next.h"
 #include "CommonLib/dtrace_buffer.h"
+#include "CommonLib/ToolTimer.h"
 
 #include "EncModeCtrl.h"
 #include "EncLib.h"
@@ -56,6 +57,13 @@
  //! \ingroup EncoderLib
  //! \{
 
+#if ENABLE_TOOL_TIMING
+static inline ToolTimerId getAffineToolTimer( const CodingUnit& cu )
+{
+  return cu.affineType == AFFINEMODEL_8PARAM ? TOOL_PERSPECTIVE_ME : cu.affineType == AFFINEMODEL_6PARAM ? TOOL_AFFINE_ME_6PARAM : TOOL_AFFINE_ME_4PARAM;
+}
+#endif
+
 static const Mv s_acMvRefineH[9] =
 {
   Mv(  0,  0 ), // 0
@@ -95,6 +103,16 @@ InterSearch::InterSearch()
   , m_CABACEstimator              (nullptr)
   , m_CtxCache                    (nullptr)
   , m_pTempPel                    (nullptr)
+  , m_fracPelStride               (0)
+  , m_fracPelTmpStride            (0)
+#if ENABLE_HALF_PEL_PLANE_CACHE
+  , m_halfPelNumUsed              (0)
+  , m_halfPelPic                  (nullptr)
+  , m_halfPelPoc                  (0)
+  , m_halfPelRange                (0)
+  , m_halfPelNumTiles             (0)
+  , m_halfPelStride               (0)
+#endif
   , m_isInitialized               (false)
 {
   for (int i=0; i<MAX_NUM_REF_LIST_ADAPT_SR; i++)
@@ -142,6 +160,11 @@ void InterSearch::destroy()
   {
     delete[] m_tmpAffiDeri[1];
   }
+#if ENABLE_HALF_PEL_PLANE_CACHE
+  m_halfPelPlanes.clear();
+  m_halfPelNumUsed = 0;
+  m_halfPelPic     = nullptr;
+#endif
   m_isInitialized = false;
 }
 
@@ -242,6 +265,15 @@ void InterSearch::init( EncCfg*        pcEncCfg,
 #endif
   m_pTempPel = new Pel[maxCUWidth*maxCUHeight];
 
+#if ENABLE_HALF_PEL_PLANE_CACHE
+  // the window covers the search range around the CTU plus the interpolation filter support
+  m_halfPelRange    = ( ( iSearchRange + NTAPS_LUMA + HALF_PEL_TILE_SIZE - 1 ) / HALF_PEL_TILE_SIZE ) * HALF_PEL_TILE_SIZE;
+  m_halfPelNumTiles = ( ( std::max( maxCUWidth, maxCUHeight ) + HALF_PEL_TILE_SIZE - 1 ) / HALF_PEL_TILE_SIZE ) + 2 * m_halfPelRange / HALF_PEL_TILE_SIZE;
+  m_halfPelStride   = m_halfPelNumTiles * HALF_PEL_TILE_SIZE;
+  m_halfPelNumUsed  = 0;
+  m_halfPelPic      = nullptr;
+#endif
+
   m_isInitialized = true;
 }
 
@@ -640,11 +672,18 @@ Distortion InterSearch::xPatternRefinement( const CPelBuf* pcPatternKey,
   Distortion  uiDistBest  = std::numeric_limits<Distortion>::max();
   uint32_t        uiDirecBest = 0;
 
-  Pel*  piRefPos;
-  int iRefStride = pcPatternKey->width + 1;
-  m_pcRdCost->setDistParam( m_cDistParam, *pcPatternKey, m_filteredBlock[0][0][0], iRefStride, m_lumaClpRng.bd, COMPONENT_Y, 0, 1, m_pcEncCfg->getUseHADME() && bAllowUseOfHadamard );
+  const Pel* piRefPos;
+  int iRefStride = m_fracPelStride;
+  m_pcRdCost->setDistParam( m_cDistParam, *pcPatternKey, m_fracPelBuf[0][0], iRefStride, m_lumaClpRng.bd, COMPONENT_Y, 0, 1, m_pcEncCfg->getUseHADME() && bAllowUseOfHadamard );
 
   const Mv* pcMvRefine = (iFrac == 2 ? s_acMvRefineH : s_acMvRefineQ);
+  const Pel* piRefPosTest[9];
+  Distortion uiDistTest  [9];
+
+  // the candidates share the same original block, so they are scored in one batch, the generic
+  // implementation has no early exit and is left to the per-candidate loop below
+  const bool bBatchDist = RdCost::isDistMultiBatched( m_cDistParam );
+
   for (uint32_t i = 0; i < 9; i++)
   {
     Mv cMvTest = pcMvRefine[i];
@@ -652,7 +691,7 @@ Distortion InterSearch::xPatternRefinement( const CPelBuf* pcPatternKey,
 
     int horVal = cMvTest.getHor() * iFrac;
     int verVal = cMvTest.getVer() * iFrac;
-    piRefPos = m_filteredBlock[verVal & 3][horVal & 3][0];
+    piRefPos = m_fracPelBuf[verVal & 3][horVal & 3];
 
     if (horVal == 2 && (verVal & 1) == 0)
     {
@@ -662,12 +701,28 @@ Distortion InterSearch::xPatternRefinement( const CPelBuf* pcPatternKey,
     {
       piRefPos += iRefStride;
     }
-    cMvTest = pcMvRefine[i];
-    cMvTest += rcMvFrac;
+    piRefPosTest[i] = piRefPos;
+  }
+
+  if( bBatchDist )
+  {
+    m_cDistParam.distFuncMulti( m_cDistParam, piRefPosTest, 9, uiDistTest );
+  }
 
+  for (uint32_t i = 0; i < 9; i++)
+  {
+    Mv cMvTest = pcMvRefine[i];
+    cMvTest += rcMvFrac;
 
-    m_cDistParam.cur.buf   = piRefPos;
-    uiDist = m_cDistParam.distFunc( m_cDistParam );
+    if( bBatchDist )
+    {
+      uiDist = uiDistTest[i];
+    }
+    else
+    {
+      m_cDistParam.cur.buf = piRefPosTest[i];
+      uiDist = m_cDistParam.distFunc( m_cDistParam );
+    }
 #if JVET_K0357_AMVR
     uiDist += m_pcRdCost->getCostOfVectorWithPredictor( cMvTest.getHor(), cMvTest.getVer(), 0 );
 #else
@@ -1273,9 +1328,9 @@ void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
 #if JVET_K_AFFINE
 #if JVET_K0220_ENC_CTRL
 #if JVET_K0357_AMVR
-    if (cu.Y().width > 8 && cu.Y().height > 8 && cu.partSize == SIZE_2Nx2N && cu.slice->getSPS()->getSpsNext().getUseAffine() && cu.imv == 0)
+    if (cu.Y().width > 8 && cu.Y().height > 8 && cu.partSize == SIZE_2Nx2N && cu.slice->getSPS()->getSpsNext().getUseAffine() && cu.imv == 0 && m_modeCtrl->tryAffineModel( cs, partitioner, false ))
 #else
-    if (cu.Y().width > 8 && cu.Y().height > 8 && cu.partSize == SIZE_2Nx2N && cu.slice->getSPS()->getSpsNext().getUseAffine())
+    if (cu.Y().width > 8 && cu.Y().height > 8 && cu.partSize == SIZE_2Nx2N && cu.slice->getSPS()->getSpsNext().getUseAffine() && m_modeCtrl->tryAffineModel( cs, partitioner, false ))
 #endif
 #else
 #if JVET_K0357_AMVR
@@ -1331,13 +1386,12 @@ void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
 			  bestMvpNum[0] = pu.mvpNum[0];
 			  bestMvpNum[1] = pu.mvpNum[1];
 
-			  const CMotionBuf &mb = pu.getMotionBuf();
 			  for (int refList = 0; refList < 2; refList++)
 			  {
-				  bestMv[refList][0] = mb.at(0, 0).mv[refList];
-				  bestMv[refList][1] = mb.at(mb.width - 1, 0).mv[refList];
-				  bestMv[refList][2] = mb.at(0, mb.height - 1).mv[refList];
-				  bestMv[refList][3] = mb.at(mb.width - 1, mb.height - 1).mv[refList];
+				  bestMv[refList][0] = pu.mvAffi[refList][0];
+				  bestMv[refList][1] = pu.mvAffi[refList][1];
+				  bestMv[refList][2] = pu.mvAffi[refList][2];
+				  bestMv[refList][3] = pu.mvAffi[refList][3];
 
 				  bestMvd[refList][0] = pu.mvdAffi[refList][0];
 				  bestMvd[refList][1] = pu.mvdAffi[refList][1];
@@ -1373,8 +1427,8 @@ void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
 					  pu.mvdAffi[REF_PIC_LIST_1][verIdx] = bestMvd[1][verIdx];
 				  }
 
-				  PU::setAllAffineMv(pu, bestMv[0][0], bestMv[0][1], bestMv[0][2], bestMv[0][3], REF_PIC_LIST_0);
-				  PU::setAllAffineMv(pu, bestMv[1][0], bestMv[1][1], bestMv[1][2], bestMv[1][3], REF_PIC_LIST_1);
+				  PU::setAllAffineMv(pu, bestMv[0][0], bestMv[0][1], bestMv[0][2], bestMv[0][3], REF_PIC_LIST_0, false);
+				  PU::setAllAffineMv(pu, bestMv[1][0], bestMv[1][1], bestMv[1][2], bestMv[1][3], REF_PIC_LIST_1, false);
 			  }
 			  else
 			  {
@@ -1419,6 +1473,13 @@ void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
     m_maxCompIDToPred = MAX_NUM_COMPONENT;
 
     {
+#if JVET_K_AFFINE
+      if ( cu.affine )
+      {
+        // the affine search only keeps the control point MVs, span the sub-block motion of the decision
+        PU::spanAffineMv( pu );
+      }
+#endif
       PU::spanMotionInfo( pu, mergeCtx );
     }
 
@@ -2041,6 +2102,11 @@ void InterSearch::predInterSearchPersp(CodingUnit& cu, Partitioner& partitioner,
 		m_maxCompIDToPred = MAX_NUM_COMPONENT;
 
 		{
+			if (cu.affine)
+			{
+				// the affine search only keeps the control point MVs, span the sub-block motion of the decision
+				PU::spanAffineMv(pu);
+			}
 			PU::spanMotionInfo(pu, mergeCtx);
 		}
 
@@ -2323,6 +2389,8 @@ void InterSearch::xMotionEstimation(PredictionUnit& pu, PelUnitBuf& origBuf, Ref
 #if JVET_K0357_AMVR
   cStruct.imvShift      = pu.cu->imv << 1;
 #endif
+  cStruct.usePreSearchMv = m_pcEncCfg->getUseMEPreSearch() &&
+                           pu.cs->picture->getPreSearchMv( eRefPicList, iRefIdxPred, pu.lumaPos().offset( pu.lwidth() >> 1, pu.lheight() >> 1 ), cStruct.preSearchMv );
   auto blkCache = dynamic_cast<CacheBlkInfoCtrl*>( m_modeCtrl );
 
   bool bQTBTMV  = false;
@@ -2544,6 +2612,8 @@ void InterSearch::xTZSearch( const PredictionUnit& pu,
                              const bool            bExtendedSettings,
                              const bool            bFastSettings)
 {
+  TOOL_TIMER( TOOL_TZ_SEARCH );
+
   const bool bUseRasterInFastMode                    = true; //toggle this to further reduce runtime
 
   const bool bUseAdaptiveRaster                      = bExtendedSettings;
@@ -2616,6 +2686,19 @@ void InterSearch::xTZSearch( const PredictionUnit& pu,
       xTZSearchHelp( cStruct, integerMv2Nx2NPred.getHor(), integerMv2Nx2NPred.getVer(), 0, 0);
     }
   }
+  if( cStruct.usePreSearchMv )
+  {
+    Mv preSearchMv = cStruct.preSearchMv;
+    preSearchMv <<= 2;
+    clipMv( preSearchMv, pu.cu->lumaPos(), *pu.cs->sps );
+    preSearchMv.divideByPowerOf2(2);
+
+    if( preSearchMv.getHor() != cStruct.iBestX || preSearchMv.getVer() != cStruct.iBestY )
+    {
+      // test the start point of the hierarchical pre-search
+      xTZSearchHelp( cStruct, preSearchMv.getHor(), preSearchMv.getVer(), 0, 0 );
+    }
+  }
   {
     // set search range
     Mv currBestMv(cStruct.iBestX, cStruct.iBestY );
@@ -2822,6 +2905,8 @@ void InterSearch::xTZSearchSelective( const PredictionUnit& pu,
                                       Distortion            &ruiSAD,
                                       const Mv* const       pIntegerMv2Nx2NPred )
 {
+  TOOL_TIMER( TOOL_TZ_SEARCH );
+
   const bool bTestZeroVector          = true;
   const bool bEnableRasterSearch      = true;
   const bool bAlwaysRasterSearch      = false;  // 1: BETTER but factor 15x slower
@@ -2876,6 +2961,15 @@ void InterSearch::xTZSearchSelective( const PredictionUnit& pu,
     xTZSearchHelp( cStruct, integerMv2Nx2NPred.getHor(), integerMv2Nx2NPred.getVer(), 0, 0);
 
   }
+  if( cStruct.usePreSearchMv )
+  {
+    Mv preSearchMv = cStruct.preSearchMv;
+    preSearchMv <<= 2;
+    clipMv( preSearchMv, pu.cu->lumaPos(), *pu.cs->sps );
+    preSearchMv.divideByPowerOf2(2);
+
+    xTZSearchHelp( cStruct, preSearchMv.getHor(), preSearchMv.getVer(), 0, 0 );
+  }
   {
     // set search range
     Mv currBestMv(cStruct.iBestX, cStruct.iBestY );
@@ -3090,6 +3184,10 @@ void InterSearch::xPatternSearchFracDIF(
 
   //  Half-pel refinement
   m_pcRdCost->setCostScale(1);
+#if ENABLE_HALF_PEL_PLANE_CACHE
+  const Position intPos = pu.lumaPos().offset( rcMvInt.getHor(), rcMvInt.getVer() );
+  if( !xGetHalfPelPlanes( pu, pu.cu->slice->getRefPic( eRefPicList, iRefIdx ), intPos, *cStruct.pcPatternKey ) )
+#endif
   xExtDIFUpSamplingH ( &cPatternRoi );
 
   rcMvHalf = rcMvInt;   rcMvHalf <<= 1;    // for mv-cost
@@ -3126,6 +3224,8 @@ void InterSearch::xPredAffineInterSearch( PredictionUnit&       pu,
 #endif
                                          )
 {
+  TOOL_TIMER( getAffineToolTimer( *pu.cu ) );
+
   const Slice &slice = *pu.cu->slice;
 
   affineCost = std::numeric_limits<Distortion>::max();
@@ -3339,6 +3439,28 @@ void InterSearch::xPredAffineInterSearch( PredictionUnit&       pu,
 	  }
 
 #endif
+      // corner motion of the hierarchical pre-search as start point
+      if ( m_pcEncCfg->getUseMEPreSearch() )
+      {
+        const Position corners[4] = { pu.lumaPos(), pu.Y().topRight(), pu.Y().bottomLeft(), pu.Y().bottomRight() };
+        Mv   mvPreSearch[4];
+        bool valid = true;
+        for ( int i = 0; i < 4 && valid; i++ )
+        {
+          Mv mv;
+          valid = pu.cs->picture->getPreSearchMv( eRefPicList, iRefIdxTemp, corners[i], mv );
+          mvPreSearch[i] = Mv( mv.getHor() << 2, mv.getVer() << 2 );
+        }
+        if ( valid )
+        {
+          Distortion uiCandCostPreSearch = xGetAffineTemplateCost( pu, origBuf, predBuf, mvPreSearch, aaiMvpIdx[iRefList][iRefIdxTemp], AMVP_MAX_NUM_CANDS, eRefPicList, iRefIdxTemp );
+          if ( uiCandCostPreSearch < uiCandCost )
+          {
+            uiCandCost = uiCandCostPreSearch;
+            ::memcpy( mvHevc, mvPreSearch, sizeof( Mv ) * 4 );
+          }
+        }
+      }
       if ( uiCandCost < biPDistTemp )
       {
         ::memcpy( cMvTemp[iRefList][iRefIdxTemp], mvHevc, sizeof(Mv)*4 );
@@ -3477,7 +3599,7 @@ void InterSearch::xPredAffineInterSearch( PredictionUnit&       pu,
       iRefIdxBi[1] = bestBiPRefIdxL1;
 
       // Get list1 prediction block
-      PU::setAllAffineMv( pu, cMvBi[1][0], cMvBi[1][1], cMvBi[1][2], cMvBi[1][3], REF_PIC_LIST_1 );
+      PU::setAllAffineMv( pu, cMvBi[1][0], cMvBi[1][1], cMvBi[1][2], cMvBi[1][3], REF_PIC_LIST_1, false );
       pu.refIdx[REF_PIC_LIST_1] = iRefIdxBi[1];
 
       PelUnitBuf predBufTmp = m_tmpPredStorage[REF_PIC_LIST_1].getBuf( UnitAreaRelative(*pu.cu, pu) );
@@ -3536,7 +3658,7 @@ void InterSearch::xPredAffineInterSearch( PredictionUnit&       pu,
       // First iterate, get prediction block of opposite direction
       if( iIter == 0 && !slice.getMvdL1ZeroFlag() )
       {
-        PU::setAllAffineMv( pu, aacMv[1-iRefList][0], aacMv[1-iRefList][1], aacMv[1-iRefList][2], aacMv[1 - iRefList][3], RefPicList(1-iRefList) );
+        PU::setAllAffineMv( pu, aacMv[1-iRefList][0], aacMv[1-iRefList][1], aacMv[1-iRefList][2], aacMv[1 - iRefList][3], RefPicList(1-iRefList), false );
         pu.refIdx[1-iRefList] = iRefIdx[1-iRefList];
 
         PelUnitBuf predBufTmp = m_tmpPredStorage[1 - iRefList].getBuf( UnitAreaRelative(*pu.cu, pu) );
@@ -3595,7 +3717,7 @@ void InterSearch::xPredAffineInterSearch( PredictionUnit&       pu,
           if ( iNumIter != 1 ) // MC for next iter
           {
             //  Set motion
-            PU::setAllAffineMv( pu, cMvBi[iRefList][0], cMvBi[iRefList][1], cMvBi[iRefList][2], cMvBi[iRefList][3], eRefPicList );
+            PU::setAllAffineMv( pu, cMvBi[iRefList][0], cMvBi[iRefList][1], cMvBi[iRefList][2], cMvBi[iRefList][3], eRefPicList, false );
             pu.refIdx[eRefPicList] = iRefIdxBi[eRefPicList];
             PelUnitBuf predBufTmp = m_tmpPredStorage[iRefList].getBuf( UnitAreaRelative(*pu.cu, pu) );
             motionCompensation( pu, predBufTmp, eRefPicList );
@@ -3650,8 +3772,8 @@ void InterSearch::xPredAffineInterSearch( PredictionUnit&       pu,
     lastMode = 2;
     affineCost = uiCostBi;
 
-    PU::setAllAffineMv( pu, cMvBi[0][0], cMvBi[0][1], cMvBi[0][2], cMvBi[0][3], REF_PIC_LIST_0 );
-    PU::setAllAffineMv( pu, cMvBi[1][0], cMvBi[1][1], cMvBi[1][2], cMvBi[1][3], REF_PIC_LIST_1 );
+    PU::setAllAffineMv( pu, cMvBi[0][0], cMvBi[0][1], cMvBi[0][2], cMvBi[0][3], REF_PIC_LIST_0, false );
+    PU::setAllAffineMv( pu, cMvBi[1][0], cMvBi[1][1], cMvBi[1][2], cMvBi[1][3], REF_PIC_LIST_1, false );
     pu.refIdx[REF_PIC_LIST_0] = iRefIdxBi[0];
     pu.refIdx[REF_PIC_LIST_1] = iRefIdxBi[1];
 
@@ -3680,7 +3802,7 @@ void InterSearch::xPredAffineInterSearch( PredictionUnit&       pu,
     lastMode = 0;
     affineCost = uiCost[0];
 
-    PU::setAllAffineMv( pu, aacMv[0][0], aacMv[0][1], aacMv[0][2], aacMv[0][3], REF_PIC_LIST_0 );
+    PU::setAllAffineMv( pu, aacMv[0][0], aacMv[0][1], aacMv[0][2], aacMv[0][3], REF_PIC_LIST_0, false );
     pu.refIdx[REF_PIC_LIST_0] = iRefIdx[0];
 
     for ( int verIdx = 0; verIdx < mvNum; verIdx++ )
@@ -3703,7 +3825,7 @@ void InterSearch::xPredAffineInterSearch( PredictionUnit&       pu,
     lastMode = 1;
     affineCost = uiCost[1];
 
-    PU::setAllAffineMv( pu, aacMv[1][0], aacMv[1][1], aacMv[1][2], aacMv[1][3], REF_PIC_LIST_1 );
+    PU::setAllAffineMv( pu, aacMv[1][0], aacMv[1][1], aacMv[1][2], aacMv[1][3], REF_PIC_LIST_1, false );
     pu.refIdx[REF_PIC_LIST_1] = iRefIdx[1];
 
     for ( int verIdx = 0; verIdx < mvNum; verIdx++ )
@@ -4104,6 +4226,8 @@ void InterSearch::xAffineMotionEstimation( PredictionUnit& pu,
 #endif
   for ( int iter=0; iter<iIterTime; iter++ )    // iterate loop
   {
+    TOOL_TIMER_ITERATIONS( getAffineToolTimer( *pu.cu ), 1 );
+
     /*********************************************************************************
      *                         use gradient to update mv
      *********************************************************************************/
@@ -4563,6 +4687,18 @@ void InterSearch::xExtDIFUpSamplingH( CPelBuf* pattern )
   dstPtr = m_filteredBlock[2][2][0];
   m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width + 1, height + 1, 2, false, true, chFmt, clpRng);
 #endif
+
+  for( int i = 0; i < LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS; i++ )
+  {
+    for( int j = 0; j < LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS; j++ )
+    {
+      m_fracPelBuf[i][j] = m_filteredBlock[i][j][0];
+    }
+  }
+  m_fracPelStride    = dstStride;
+  m_fracPelTmp[0]    = m_filteredBlockTmp[0][0];
+  m_fracPelTmp[1]    = m_filteredBlockTmp[2][0];
+  m_fracPelTmpStride = intStride;
 }
 
 
@@ -4588,6 +4724,8 @@ void InterSearch::xExtDIFUpSamplingQ( CPelBuf* pattern, Mv halfPelRef )
   int dstStride = width + 1;
   Pel *intPtr;
   Pel *dstPtr;
+  Pel const* tmpPtr;
+  const int tmpStride = m_fracPelTmpStride;
   int filterSize = NTAPS_LUMA;
 
   int halfFilterSize = (filterSize>>1);
@@ -4704,65 +4842,65 @@ void InterSearch::xExtDIFUpSamplingQ( CPelBuf* pattern, Mv halfPelRef )
   if (halfPelRef.getHor() != 0)
   {
     // Generate @ 1,2
-    intPtr = m_filteredBlockTmp[2][0] + (halfFilterSize - 1) * intStride;
+    tmpPtr = m_fracPelTmp[1] + (halfFilterSize - 1) * tmpStride;
     dstPtr = m_filteredBlock[1][2][0];
     if (halfPelRef.getHor() > 0)
     {
-      intPtr += 1;
+      tmpPtr += 1;
     }
     if (halfPelRef.getVer() >= 0)
     {
-      intPtr += intStride;
+      tmpPtr += tmpStride;
     }
 #if JVET_K0346 || JVET_K_AFFINE
-    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 1 << VCEG_AZ07_MV_ADD_PRECISION_BIT_FOR_STORE, false, true, chFmt, clpRng);
+    m_if.filterVer(COMPONENT_Y, tmpPtr, tmpStride, dstPtr, dstStride, width, height, 1 << VCEG_AZ07_MV_ADD_PRECISION_BIT_FOR_STORE, false, true, chFmt, clpRng);
 #else
-    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 1, false, true, chFmt, clpRng);
+    m_if.filterVer(COMPONENT_Y, tmpPtr, tmpStride, dstPtr, dstStride, width, height, 1, false, true, chFmt, clpRng);
 #endif
 
     // Generate @ 3,2
-    intPtr = m_filteredBlockTmp[2][0] + (halfFilterSize - 1) * intStride;
+    tmpPtr = m_fracPelTmp[1] + (halfFilterSize - 1) * tmpStride;
     dstPtr = m_filteredBlock[3][2][0];
     if (halfPelRef.getHor() > 0)
     {
-      intPtr += 1;
+      tmpPtr += 1;
     }
     if (halfPelRef.getVer() > 0)
     {
-      intPtr += intStride;
+      tmpPtr += tmpStride;
     }
 #if JVET_K0346 || JVET_K_AFFINE
-    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 3 << VCEG_AZ07_MV_ADD_PRECISION_BIT_FOR_STORE, false, true, chFmt, clpRng);
+    m_if.filterVer(COMPONENT_Y, tmpPtr, tmpStride, dstPtr, dstStride, width, height, 3 << VCEG_AZ07_MV_ADD_PRECISION_BIT_FOR_STORE, false, true, chFmt, clpRng);
 #else
-    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 3, false, true, chFmt, clpRng);
+    m_if.filterVer(COMPONENT_Y, tmpPtr, tmpStride, dstPtr, dstStride, width, height, 3, false, true, chFmt, clpRng);
 #endif
   }
   else
   {
     // Generate @ 1,0
-    intPtr = m_filteredBlockTmp[0][0] + (halfFilterSize - 1) * intStride + 1;
+    tmpPtr = m_fracPelTmp[0] + (halfFilterSize - 1) * tmpStride + 1;
     dstPtr = m_filteredBlock[1][0][0];
     if (halfPelRef.getVer() >= 0)
     {
-      intPtr += intStride;
+      tmpPtr += tmpStride;
     }
 #if JVET_K0346 || JVET_K_AFFINE
-    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 1 << VCEG_AZ07_MV_ADD_PRECISION_BIT_FOR_STORE, false, true, chFmt, clpRng);
+    m_if.filterVer(COMPONENT_Y, tmpPtr, tmpStride, dstPtr, dstStride, width, height, 1 << VCEG_AZ07_MV_ADD_PRECISION_BIT_FOR_STORE, false, true, chFmt, clpRng);
 #else
-    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 1, false, true, chFmt, clpRng);
+    m_if.filterVer(COMPONENT_Y, tmpPtr, tmpStride, dstPtr, dstStride, width, height, 1, false, true, chFmt, clpRng);
 #endif
 
     // Generate @ 3,0
-    intPtr = m_filteredBlockTmp[0][0] + (halfFilterSize - 1) * intStride + 1;
+    tmpPtr = m_fracPelTmp[0] + (halfFilterSize - 1) * tmpStride + 1;
     dstPtr = m_filteredBlock[3][0][0];
     if (halfPelRef.getVer() > 0)
     {
-      intPtr += intStride;
+      tmpPtr += tmpStride;
     }
 #if JVET_K0346 || JVET_K_AFFINE
-    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 3 << VCEG_AZ07_MV_ADD_PRECISION_BIT_FOR_STORE, false, true, chFmt, clpRng);
+    m_if.filterVer(COMPONENT_Y, tmpPtr, tmpStride, dstPtr, dstStride, width, height, 3 << VCEG_AZ07_MV_ADD_PRECISION_BIT_FOR_STORE, false, true, chFmt, clpRng);
 #else
-    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 3, false, true, chFmt, clpRng);
+    m_if.filterVer(COMPONENT_Y, tmpPtr, tmpStride, dstPtr, dstStride, width, height, 3, false, true, chFmt, clpRng);
 #endif
   }
 
@@ -4787,7 +4925,207 @@ void InterSearch::xExtDIFUpSamplingQ( CPelBuf* pattern, Mv halfPelRef )
 #else
   m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 3, false, true, chFmt, clpRng);
 #endif
+
+  // the centre of the quarter-sample refinement is the best half-sample pattern, which has to be brought to the
+  // block stride when it was read from the cached planes
+  const int centerVer = ( halfPelRef.getVer() << 1 ) & 3;
+  const int centerHor = ( halfPelRef.getHor() << 1 ) & 3;
+  if( m_fracPelBuf[centerVer][centerHor] != m_filteredBlock[centerVer][centerHor][0] )
+  {
+    const Pel* src = m_fracPelBuf[centerVer][centerHor];
+    dstPtr         = m_filteredBlock[centerVer][centerHor][0];
+    const int copyWidth  = width  + ( centerHor ? 1 : 0 );
+    const int copyHeight = height + ( centerVer ? 1 : 0 );
+    for( int y = 0; y < copyHeight; y++ )
+    {
+      memcpy( dstPtr, src, copyWidth * sizeof( Pel ) );
+      src    += m_fracPelStride;
+      dstPtr += dstStride;
+    }
+  }
+
+  for( int i = 0; i < LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS; i++ )
+  {
+    for( int j = 0; j < LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS; j++ )
+    {
+      m_fracPelBuf[i][j] = m_filteredBlock[i][j][0];
+    }
+  }
+  m_fracPelStride = dstStride;
+}
+
+#if ENABLE_HALF_PEL_PLANE_CACHE
+/**
+* \brief Point the half-sample patterns of a block into the cached half-sample planes of its reference
+*
+* The planes cover a window around the current CTU and are interpolated per tile on first use, so the blocks of the
+* split hierarchy share the filtering. The cache is dropped when the encoder moves on to another CTU.
+*
+* \param pu      Prediction unit
+* \param refPic  Reference picture
+* \param pos     Integer-sample position of the block in the reference picture
+* \param size    Block size
+* \return        false if the block is not covered by the window, the patterns then have to be interpolated per block
+*/
+bool InterSearch::xGetHalfPelPlanes( const PredictionUnit& pu, const Picture* refPic, const Position& pos, const Size& size )
+{
+  const PreCalcValues& pcv = *pu.cs->pcv;
+  const Position ctuPos( ( pu.lx() >> pcv.maxCUWidthLog2 ) << pcv.maxCUWidthLog2, ( pu.ly() >> pcv.maxCUHeightLog2 ) << pcv.maxCUHeightLog2 );
+
+  if( pu.cs->picture != m_halfPelPic || pu.cs->slice->getPOC() != m_halfPelPoc || ctuPos != m_halfPelCtuPos )
+  {
+    m_halfPelPic     = pu.cs->picture;
+    m_halfPelPoc     = pu.cs->slice->getPOC();
+    m_halfPelCtuPos  = ctuPos;
+    m_halfPelOrigin  = Position( ctuPos.x - m_halfPelRange, ctuPos.y - m_halfPelRange );
+    m_halfPelNumUsed = 0;
+  }
+
+  // the half-sample patterns span [x, x + width] x [y, y + height], their horizontal pre-filtered
+  // rows [x - 1, x + width - 1] x [y - 4, y + height + 3]
+  const int halfFilterSize = NTAPS_LUMA >> 1;
+  const int margin         = refPic->margin;
+  if( pos.x < -margin + halfFilterSize || pos.x + ( int ) size.width  >= ( int ) refPic->lwidth()  + margin - halfFilterSize - 1
+   || pos.y < -margin + halfFilterSize || pos.y + ( int ) size.height >= ( int ) refPic->lheight() + margin - halfFilterSize - 1 )
+  {
+    return false;
+  }
+
+  const int left   = pos.x - 1                                 - m_halfPelOrigin.x;
+  const int right  = pos.x + ( int ) size.width                - m_halfPelOrigin.x;
+  const int top    = pos.y - halfFilterSize                    - m_halfPelOrigin.y;
+  const int bottom = pos.y + ( int ) size.height + halfFilterSize - 1 - m_halfPelOrigin.y;
+  if( left < 0 || top < 0 || right >= m_halfPelStride || bottom >= m_halfPelStride )
+  {
+    return false;
+  }
+
+  HalfPelPlanes* planes = nullptr;
+  for( int i = 0; i < m_halfPelNumUsed; i++ )
+  {
+    if( m_halfPelPlanes[i].refPic == refPic )
+    {
+      planes = &m_halfPelPlanes[i];
+      break;
+    }
+  }
+  if( planes == nullptr )
+  {
+    if( m_halfPelNumUsed == ( int ) m_halfPelPlanes.size() )
+    {
+      m_halfPelPlanes.push_back( HalfPelPlanes() );
+      for( int i = 0; i < NUM_HALF_PEL_PLANES; i++ )
+      {
+        m_halfPelPlanes.back().plane[i].resize( m_halfPelStride * m_halfPelStride );
+      }
+      m_halfPelPlanes.back().tileValid.resize( m_halfPelNumTiles * m_halfPelNumTiles );
+    }
+    planes         = &m_halfPelPlanes[m_halfPelNumUsed++];
+    planes->refPic = refPic;
+    std::fill( planes->tileValid.begin(), planes->tileValid.end(), 0 );
+  }
+
+  for( int tileY = top / HALF_PEL_TILE_SIZE; tileY <= bottom / HALF_PEL_TILE_SIZE; tileY++ )
+  {
+    for( int tileX = left / HALF_PEL_TILE_SIZE; tileX <= right / HALF_PEL_TILE_SIZE; tileX++ )
+    {
+      if( !planes->tileValid[tileY * m_halfPelNumTiles + tileX] )
+      {
+        xBuildHalfPelTile( *planes, tileX, tileY );
+        planes->tileValid[tileY * m_halfPelNumTiles + tileX] = 1;
+      }
+    }
+  }
+
+  const int offset    = ( pos.y - m_halfPelOrigin.y ) * m_halfPelStride + pos.x - m_halfPelOrigin.x;
+  const int offsetTmp = offset - halfFilterSize * m_halfPelStride - 1;
+
+  for( int i = 0; i < LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS; i++ )
+  {
+    for( int j = 0; j < LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS; j++ )
+    {
+      m_fracPelBuf[i][j] = m_filteredBlock[i][j][0];
+    }
+  }
+  m_fracPelBuf[0][0] = planes->plane[HPP_00].data() + offset;
+  m_fracPelBuf[2][0] = planes->plane[HPP_20].data() + offset;
+  m_fracPelBuf[0][2] = planes->plane[HPP_02].data() + offset;
+  m_fracPelBuf[2][2] = planes->plane[HPP_22].data() + offset;
+  m_fracPelStride    = m_halfPelStride;
+  m_fracPelTmp[0]    = planes->plane[HPP_TMP_INT ].data() + offsetTmp;
+  m_fracPelTmp[1]    = planes->plane[HPP_TMP_HALF].data() + offsetTmp;
+  m_fracPelTmpStride = m_halfPelStride;
+
+  return true;
+}
+
+/**
+* \brief Interpolate one tile of the half-sample planes
+*
+* Every sample is filtered exactly as xExtDIFUpSamplingH does for a block at the same position: the horizontal
+* pre-filtered rows at integer (HPP_TMP_INT) and half-sample (HPP_TMP_HALF) phase, and the patterns at the half-sample
+* phases [ver][hor] = 00, 20, 02 and 22, each stored at the position of the integer sample it is read for.
+*/
+void InterSearch::xBuildHalfPelTile( HalfPelPlanes& planes, int tileX, int tileY )
+{
+  const ClpRng&      clpRng         = m_lumaClpRng;
+  const ChromaFormat chFmt          = m_currChromaFormat;
+  const int          halfFilterSize = NTAPS_LUMA >> 1;
+  const int          margin         = planes.refPic->margin;
+  const int          picWidth       = planes.refPic->lwidth();
+  const int          picHeight      = planes.refPic->lheight();
+  const CPelBuf      refBuf         = planes.refPic->getRecoBuf( COMPONENT_Y );
+  const int          stride         = m_halfPelStride;
+#if JVET_K0346 || JVET_K_AFFINE
+  const int          halfFrac       = 2 << VCEG_AZ07_MV_ADD_PRECISION_BIT_FOR_STORE;
+#else
+  const int          halfFrac       = 2;
+#endif
+
+  const int x0 = m_halfPelOrigin.x + tileX * HALF_PEL_TILE_SIZE;
+  const int y0 = m_halfPelOrigin.y + tileY * HALF_PEL_TILE_SIZE;
+  const int tileOffset = tileY * HALF_PEL_TILE_SIZE * stride + tileX * HALF_PEL_TILE_SIZE;
+
+  // horizontal pre-filtered rows, as far as the filter support stays inside the padded reference
+  {
+    const int left   = std::max( x0, -margin + halfFilterSize - 1 );
+    const int right  = std::min( x0 + HALF_PEL_TILE_SIZE, picWidth + margin - halfFilterSize );
+    const int top    = std::max( y0, -margin );
+    const int bottom = std::min( y0 + HALF_PEL_TILE_SIZE, picHeight + margin );
+    if( left < right && top < bottom )
+    {
+      const Pel* srcPtr = refBuf.bufAt( left, top );
+      const int  offset = tileOffset + ( top - y0 ) * stride + left - x0;
+      m_if.filterHor( COMPONENT_Y, srcPtr, refBuf.stride, planes.plane[HPP_TMP_INT ].data() + offset, stride, right - left, bottom - top, 0,        false, chFmt, clpRng );
+      m_if.filterHor( COMPONENT_Y, srcPtr, refBuf.stride, planes.plane[HPP_TMP_HALF].data() + offset, stride, right - left, bottom - top, halfFrac, false, chFmt, clpRng );
+    }
+  }
+
+  // half-sample patterns, vertically filtered from a local copy of the pre-filtered rows around the tile
+  {
+    const int left   = std::max( x0, -margin + halfFilterSize );
+    const int right  = std::min( x0 + HALF_PEL_TILE_SIZE, picWidth + margin - halfFilterSize - 1 );
+    const int top    = std::max( y0, -margin + halfFilterSize );
+    const int bottom = std::min( y0 + HALF_PEL_TILE_SIZE, picHeight + margin - halfFilterSize - 1 );
+    if( left < right && top < bottom )
+    {
+      const int width     = right - left;
+      const int height    = bottom - top;
+      const int intStride = width + 1;
+      const Pel* srcPtr   = refBuf.bufAt( left - 1, top - halfFilterSize );
+
+      m_if.filterHor( COMPONENT_Y, srcPtr, refBuf.stride, m_filteredBlockTmp[0][0], intStride, width + 1, height + NTAPS_LUMA, 0,        false, chFmt, clpRng );
+      m_if.filterHor( COMPONENT_Y, srcPtr, refBuf.stride, m_filteredBlockTmp[2][0], intStride, width + 1, height + NTAPS_LUMA, halfFrac, false, chFmt, clpRng );
+
+      const int offset = tileOffset + ( top - y0 ) * stride + left - x0;
+      m_if.filterVer( COMPONENT_Y, m_filteredBlockTmp[0][0] + halfFilterSize       * intStride + 1, intStride, planes.plane[HPP_00].data() + offset, stride, width, height, 0,        false, true, chFmt, clpRng );
+      m_if.filterVer( COMPONENT_Y, m_filteredBlockTmp[0][0] + ( halfFilterSize - 1 ) * intStride + 1, intStride, planes.plane[HPP_20].data() + offset, stride, width, height, halfFrac, false, true, chFmt, clpRng );
+      m_if.filterVer( COMPONENT_Y, m_filteredBlockTmp[2][0] + halfFilterSize       * intStride,     intStride, planes.plane[HPP_02].data() + offset, stride, width, height, 0,        false, true, chFmt, clpRng );
+      m_if.filterVer( COMPONENT_Y, m_filteredBlockTmp[2][0] + ( halfFilterSize - 1 ) * intStride,     intStride, planes.plane[HPP_22].data() + offset, stride, width, height, halfFrac, false, true, chFmt, clpRng );
+    }
+  }
 }
+#endif
 
 
 
@@ -5446,6 +5784,8 @@ void InterSearch::xEstimateInterResidualQT(CodingStructure &cs, Partitioner &par
 
 void InterSearch::encodeResAndCalcRdInterCU(CodingStructure &cs, Partitioner &partitioner, const bool &skipResidual)
 {
+  TOOL_TIMER( TOOL_INTER_RESIDUAL );
+
   CodingUnit &cu = *cs.getCU( partitioner.chType );
 
   const ChromaFormat format     = cs.area.chromaFormat;;
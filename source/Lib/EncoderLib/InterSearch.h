@@ -64,6 +64,9 @@
 static const uint32_t MAX_NUM_REF_LIST_ADAPT_SR = 2;
 static const uint32_t MAX_IDX_ADAPT_SR          = 33;
 static const uint32_t NUM_MV_PREDICTORS         = 3;
+#if ENABLE_HALF_PEL_PLANE_CACHE
+static const int      HALF_PEL_TILE_SIZE        = 64;
+#endif
 
 class EncModeCtrl;
 
@@ -122,6 +125,44 @@ protected:
 
   Mv              m_integerMv2Nx2N              [NUM_REF_PIC_LIST_01][MAX_NUM_REF];
 
+  // half- and quarter-sample patterns of the fractional-pel refinement, [ver][hor] phase
+  const Pel*      m_fracPelBuf                  [LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS][LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS];
+  int             m_fracPelStride;
+  // horizontally filtered rows at integer and half-sample phase, input of the quarter-sample interpolation
+  const Pel*      m_fracPelTmp                  [2];
+  int             m_fracPelTmpStride;
+
+#if ENABLE_HALF_PEL_PLANE_CACHE
+  enum HalfPelPlaneId
+  {
+    HPP_TMP_INT = 0,
+    HPP_TMP_HALF,
+    HPP_00,
+    HPP_20,
+    HPP_02,
+    HPP_22,
+    NUM_HALF_PEL_PLANES
+  };
+
+  /// half-sample planes of one reference picture in the window around the current CTU
+  struct HalfPelPlanes
+  {
+    const Picture*       refPic;
+    std::vector<Pel>     plane[NUM_HALF_PEL_PLANES];
+    std::vector<uint8_t> tileValid;
+  };
+
+  std::vector<HalfPelPlanes> m_halfPelPlanes;
+  int             m_halfPelNumUsed;               ///< entries of m_halfPelPlanes in use for the current CTU
+  const Picture*  m_halfPelPic;
+  int             m_halfPelPoc;
+  Position        m_halfPelCtuPos;
+  Position        m_halfPelOrigin;                ///< top-left of the window in picture coordinates
+  int             m_halfPelRange;                 ///< extent of the window beyond the CTU on each side
+  int             m_halfPelNumTiles;              ///< tiles per window row and column
+  int             m_halfPelStride;
+#endif
+
   bool            m_isInitialized;
 
 
@@ -179,6 +220,8 @@ protected:
 #if JVET_K0357_AMVR
     unsigned    imvShift;
 #endif
+    bool        usePreSearchMv;
+    Mv          preSearchMv;
   } IntTZSearchStruct;
 
   // sub-functions for ME
@@ -373,6 +416,10 @@ protected:
 #endif
   void xExtDIFUpSamplingH         ( CPelBuf* pcPattern );
   void xExtDIFUpSamplingQ         ( CPelBuf* pcPatternKey, Mv halfPelRef );
+#if ENABLE_HALF_PEL_PLANE_CACHE
+  bool xGetHalfPelPlanes          ( const PredictionUnit& pu, const Picture* refPic, const Position& pos, const Size& size );
+  void xBuildHalfPelTile          ( HalfPelPlanes& planes, int tileX, int tileY );
+#endif
 
   // -------------------------------------------------------------------------------------------------------------------
   // compute symbol bits
@@ -46,6 +46,7 @@
 
 #include "CommonLib/dtrace_next.h"
 #include "CommonLib/dtrace_buffer.h"
+#include "CommonLib/ToolTimer.h"
 
 #include <math.h>
 #include <limits>
@@ -271,8 +272,119 @@ void IntraSearch::init( EncCfg*        pcEncCfg,
 // INTRA PREDICTION
 //////////////////////////////////////////////////////////////////////////
 
+// fast intra mode decision: number of gradient histogram peaks, mode range around each peak, step of the always tested coarse mode grid (0: none)
+static const int g_fastIntraModeParams[][3] =
+{
+  { 0, 0,  0 },
+  { 4, 4,  8 },
+  { 2, 2, 16 },
+  { 1, 2,  0 },
+};
+
+/** Select the luma modes of the first SATD pass for the fast intra mode decision.
+ *  The directions of the Sobel gradients of the original block are accumulated, weighted by their amplitude,
+ *  into a histogram over the angular modes. Planar, DC, the MPMs, the modes around the histogram peaks and a
+ *  coarse grid of angular modes are kept, the number of peaks and the range are given by FastIntraModeDecision.
+ * \param pu       prediction unit
+ * \param org      original luma block
+ * \param testMode returns for each mode whether it is tested
+ */
+void IntraSearch::xGetFastIntraModeCandidates( PredictionUnit &pu, const CPelBuf &org, bool *testMode )
+{
+  static const int angTable[17] = { 0, 1, 2, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 26, 29, 32 };
+
+  const int  level     = std::min<int>( m_pcEncCfg->getFastIntraModeDecision(), 3 );
+  const int  numPeaks  = g_fastIntraModeParams[level][0];
+  const int  peakRange = g_fastIntraModeParams[level][1];
+  const int  gridStep  = g_fastIntraModeParams[level][2];
+
+  uint64_t hist[NUM_LUMA_MODE] = { 0 };
+
+  for( int y = 1; y < ( int ) org.height - 1; y++ )
+  {
+    const Pel* p0 = org.bufAt( 0, y - 1 );
+    const Pel* p1 = org.bufAt( 0, y     );
+    const Pel* p2 = org.bufAt( 0, y + 1 );
+
+    for( int x = 1; x < ( int ) org.width - 1; x++ )
+    {
+      const int gx = ( p0[x + 1] + 2 * p1[x + 1] + p2[x + 1] ) - ( p0[x - 1] + 2 * p1[x - 1] + p2[x - 1] );
+      const int gy = ( p2[x - 1] + 2 * p2[x    ] + p2[x + 1] ) - ( p0[x - 1] + 2 * p0[x    ] + p0[x + 1] );
+
+      if( gx == 0 && gy == 0 )
+      {
+        continue;
+      }
+
+      // the edge runs perpendicular to the gradient
+      const int ex = -gy;
+      const int ey =  gx;
+
+      const bool isHor = abs( ex ) >= abs( ey );
+      const int  num   = isHor ? abs( ey ) : abs( ex );
+      const int  den   = isHor ? abs( ex ) : abs( ey );
+      const int  sign  = ( ex ^ ey ) < 0 ? -1 : 1;
+
+      // closest angle of the mode table to the slope num / den
+      int offset = 0;
+      while( offset < 16 && angTable[offset + 1] * den <= ( num << 5 ) )
+      {
+        offset++;
+      }
+      if( offset < 16 && ( angTable[offset + 1] * den - ( num << 5 ) ) < ( ( num << 5 ) - angTable[offset] * den ) )
+      {
+        offset++;
+      }
+
+      const int mode = isHor ? HOR_IDX + sign * offset : VER_IDX - sign * offset;
+      hist[mode] += abs( gx ) + abs( gy );
+    }
+  }
+
+  testMode[PLANAR_IDX] = true;
+  testMode[DC_IDX]     = true;
+
+  for( int mode = DC_IDX + 1; mode < NUM_LUMA_MODE; mode++ )
+  {
+    testMode[mode] = gridStep > 0 && ( mode - ( DC_IDX + 1 ) ) % gridStep == 0;
+  }
+
+  for( int peak = 0; peak < numPeaks; peak++ )
+  {
+    int bestMode = -1;
+    for( int mode = DC_IDX + 1; mode < NUM_LUMA_MODE; mode++ )
+    {
+      if( hist[mode] > 0 && ( bestMode < 0 || hist[mode] > hist[bestMode] ) )
+      {
+        bestMode = mode;
+      }
+    }
+    if( bestMode < 0 )
+    {
+      break;
+    }
+    for( int mode = std::max( DC_IDX + 1, bestMode - peakRange ); mode <= std::min( NUM_LUMA_MODE - 1, bestMode + peakRange ); mode++ )
+    {
+      testMode[mode] = true;
+      hist[mode]     = 0;
+    }
+  }
+
+  unsigned  numMPMs = pu.cs->pcv->numMPMs;
+  unsigned *uiPreds = ( unsigned* ) alloca( numMPMs * sizeof( unsigned ) );
+
+  const int numCand = PU::getIntraMPMs( pu, uiPreds );
+
+  for( int j = 0; j < numCand; j++ )
+  {
+    testMode[uiPreds[j]] = true;
+  }
+}
+
 void IntraSearch::estIntraPredLumaQT( CodingUnit &cu, Partitioner &partitioner )
 {
+  TOOL_TIMER( TOOL_INTRA_SEARCH );
+
   CodingStructure       &cs            = *cu.cs;
   const SPS             &sps           = *cs.sps;
   const uint32_t             uiWidthBit    = cs.pcv->rectCUs ? g_aucLog2[partitioner.currArea().lwidth() ] : CU::getIntraSizeIdx(cu);
@@ -371,6 +483,11 @@ void IntraSearch::estIntraPredLumaQT( CodingUnit &cu, Partitioner &partitioner )
     numModesForFullRD = numModesAvailable;
 #endif
 
+    if( m_pcEncCfg->getFastIntraModeDecision() >= 3 && numModesForFullRD > 2 )
+    {
+      numModesForFullRD--;
+    }
+
 
 #if JVET_K1000_SIMPLIFIED_EMT
     if( emtUsageFlag != 2 )
@@ -401,6 +518,14 @@ void IntraSearch::estIntraPredLumaQT( CodingUnit &cu, Partitioner &partitioner )
         bool bSatdChecked[NUM_INTRA_MODE];
         memset( bSatdChecked, 0, sizeof( bSatdChecked ) );
 
+        // gradient based pre-selection of the angular modes
+        bool bTestMode[NUM_LUMA_MODE];
+        const bool bFastIntraMode = m_pcEncCfg->getFastIntraModeDecision() > 0;
+        if( bFastIntraMode )
+        {
+          xGetFastIntraModeCandidates( pu, piOrg, bTestMode );
+        }
+
         {
           for( int modeIdx = 0; modeIdx < numModesAvailable; modeIdx++ )
           {
@@ -413,6 +538,11 @@ void IntraSearch::estIntraPredLumaQT( CodingUnit &cu, Partitioner &partitioner )
               continue;
             }
 
+            if( bFastIntraMode && !bTestMode[uiMode] )
+            {
+              continue;
+            }
+
             bSatdChecked[uiMode] = true;
 
             pu.intraDir[0] = modeIdx;
@@ -648,7 +778,10 @@ void IntraSearch::estIntraPredLumaQT( CodingUnit &cu, Partitioner &partitioner )
       // determine residual for partition
       cs.initSubStructure( *csTemp, partitioner.chType, cs.area, true );
 
-      xRecurIntraCodingLumaQT( *csTemp, partitioner );
+      {
+        TOOL_TIMER( TOOL_INTRA_RESIDUAL );
+        xRecurIntraCodingLumaQT( *csTemp, partitioner );
+      }
 
 #if JVET_K1000_SIMPLIFIED_EMT
       if( emtUsageFlag == 1 && m_pcEncCfg->getFastIntraEMT() )
@@ -703,6 +836,8 @@ void IntraSearch::estIntraPredLumaQT( CodingUnit &cu, Partitioner &partitioner )
 
 void IntraSearch::estIntraPredChromaQT(CodingUnit &cu, Partitioner &partitioner)
 {
+  TOOL_TIMER( TOOL_INTRA_SEARCH );
+
   const ChromaFormat format   = cu.chromaFormat;
   const uint32_t    numberValidComponents = getNumberValidComponents(format);
   CodingStructure &cs = *cu.cs;
@@ -788,7 +923,10 @@ void IntraSearch::estIntraPredChromaQT(CodingUnit &cu, Partitioner &partitioner)
         //----- chroma coding -----
         pu.intraDir[1] = chromaIntraMode;
 
-        xRecurIntraChromaCodingQT( cs, partitioner );
+        {
+          TOOL_TIMER( TOOL_INTRA_RESIDUAL );
+          xRecurIntraChromaCodingQT( cs, partitioner );
+        }
 
         if (cs.pps->getUseTransformSkip())
         {
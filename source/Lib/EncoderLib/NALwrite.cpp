@@ -84,42 +84,29 @@ void write(ostream& out, OutputNALUnit& nalu)
    *  - 0x00000302
    *  - 0x00000303
    */
-  vector<uint8_t>& rbsp   = nalu.m_Bitstream.getFIFO();
+  const vector<uint8_t>& rbsp = nalu.m_Bitstream.getFIFO();
+  const uint8_t*         span = rbsp.data();
+  const uint8_t*         end  = span + rbsp.size();
 
-  vector<uint8_t> outputBuffer;
-  outputBuffer.resize(rbsp.size()*2+1); //there can never be enough emulation_prevention_three_bytes to require this much space
-  std::size_t outputAmount = 0;
-  int         zeroCount    = 0;
-  for (vector<uint8_t>::iterator it = rbsp.begin(); it != rbsp.end(); it++)
+  /* the runs between the emulations are written directly from the RBSP,
+   * without copying the payload to an intermediate buffer */
+  for (const uint8_t* found = findStartCodeEmulation(span, end); found != end; found = findStartCodeEmulation(found, end))
   {
-    const uint8_t v=(*it);
-    if (zeroCount==2 && v<=3)
-    {
-      outputBuffer[outputAmount++]=emulation_prevention_three_byte[0];
-      zeroCount=0;
-    }
-
-    if (v==0)
-    {
-      zeroCount++;
-    }
-    else
-    {
-      zeroCount=0;
-    }
-    outputBuffer[outputAmount++]=v;
+    out.write(reinterpret_cast<const char*>(span), found - span);
+    out.write(reinterpret_cast<const char*>(emulation_prevention_three_byte), 1);
+    span = found;
   }
+  out.write(reinterpret_cast<const char*>(span), end - span);
 
   /* 7.4.1.1
    * ... when the last byte of the RBSP data is equal to 0x00 (which can
    * only occur when the RBSP ends in a cabac_zero_word), a final byte equal
    * to 0x03 is appended to the end of the data.
    */
-  if (zeroCount>0)
+  if (!rbsp.empty() && rbsp.back() == 0)
   {
-    outputBuffer[outputAmount++]=emulation_prevention_three_byte[0];
+    out.write(reinterpret_cast<const char*>(emulation_prevention_three_byte), 1);
   }
-  out.write(reinterpret_cast<const char*>(&(*outputBuffer.begin())), outputAmount);
 }
 
 //! \}
@@ -66,6 +66,7 @@ EncRCSeq::EncRCSeq()
   m_useLCUSeparateModel = false;
   m_adaptiveBit         = 0;
   m_lastLambda          = 0.0;
+  m_lookaheadCost       = 0.0;
 }
 
 EncRCSeq::~EncRCSeq()
@@ -158,6 +159,7 @@ void EncRCSeq::create( int totalFrames, int targetBitrate, int frameRate, int GO
   m_bitsLeft   = m_targetBits;
   m_adaptiveBit = adaptiveBit;
   m_lastLambda = 0.0;
+  m_lookaheadCost = 0.0;
 }
 
 void EncRCSeq::destroy()
@@ -271,6 +273,18 @@ void EncRCSeq::updateAfterPic ( int bits )
   m_framesLeft--;
 }
 
+void EncRCSeq::updateLookaheadCost( double cost )
+{
+  if ( m_lookaheadCost > 0.0 )
+  {
+    m_lookaheadCost = g_RCLookaheadHistWeight * m_lookaheadCost + ( 1.0 - g_RCLookaheadHistWeight ) * cost;
+  }
+  else
+  {
+    m_lookaheadCost = cost;
+  }
+}
+
 void EncRCSeq::setAllBitRatio( double basicLambda, double* equaCoeffA, double* equaCoeffB )
 {
   int* bitsRatio = new int[m_GOPSize];
@@ -287,10 +301,12 @@ EncRCGOP::EncRCGOP()
 {
   m_encRCSeq  = NULL;
   m_picTargetBitInGOP = NULL;
+  m_picComplexityWeight = NULL;
   m_numPic     = 0;
   m_targetBits = 0;
   m_picLeft    = 0;
   m_bitsLeft   = 0;
+  m_lookaheadCost = 0.0;
 }
 
 EncRCGOP::~EncRCGOP()
@@ -298,11 +314,38 @@ EncRCGOP::~EncRCGOP()
   destroy();
 }
 
-void EncRCGOP::create( EncRCSeq* encRCSeq, int numPic )
+void EncRCGOP::create( EncRCSeq* encRCSeq, int numPic, const std::vector<double>& picLookaheadCost )
 {
   destroy();
   int targetBits = xEstGOPTargetBits( encRCSeq, numPic );
 
+  // average lookahead complexity of the analysed pictures of this GOP
+  double lookaheadCost = 0.0;
+  int    numAnalysed   = 0;
+  for ( int i=0; i<(int)picLookaheadCost.size(); i++ )
+  {
+    if ( picLookaheadCost[i] > 0.0 )
+    {
+      lookaheadCost += picLookaheadCost[i];
+      numAnalysed++;
+    }
+  }
+  if ( numAnalysed > 0 )
+  {
+    lookaheadCost /= numAnalysed;
+  }
+
+  // lookahead: move bits towards GOPs that are more complex than the recent history
+  if ( lookaheadCost > 0.0 )
+  {
+    if ( encRCSeq->getLookaheadCost() > 0.0 )
+    {
+      double complexityRatio = Clip3( g_RCLookaheadMinRatio, g_RCLookaheadMaxRatio, lookaheadCost / encRCSeq->getLookaheadCost() );
+      targetBits = max( 200, int( targetBits * sqrt( complexityRatio ) ) );
+    }
+    encRCSeq->updateLookaheadCost( lookaheadCost );
+  }
+
   if ( encRCSeq->getAdaptiveBits() > 0 && encRCSeq->getLastLambda() > 0.1 )
   {
     double targetBpp = (double)targetBits / encRCSeq->getNumPixel();
@@ -363,17 +406,29 @@ void EncRCGOP::create( EncRCSeq* encRCSeq, int numPic )
     delete []equaCoeffB;
   }
 
-  m_picTargetBitInGOP = new int[numPic];
+  // lookahead: the hierarchical bit ratios are weighted by the picture complexity relative to the GOP average,
+  // the weighted ratios are normalised over the GOP so that the picture targets still add up to the GOP target
+  m_picComplexityWeight = new double[numPic];
   int i;
-  int totalPicRatio = 0;
-  int currPicRatio = 0;
   for ( i=0; i<numPic; i++ )
   {
-    totalPicRatio += encRCSeq->getBitRatio( i );
+    m_picComplexityWeight[i] = 1.0;
+    if ( (int)picLookaheadCost.size() == numPic && picLookaheadCost[i] > 0.0 && lookaheadCost > 0.0 )
+    {
+      m_picComplexityWeight[i] = sqrt( Clip3( g_RCLookaheadMinRatio, g_RCLookaheadMaxRatio, picLookaheadCost[i] / lookaheadCost ) );
+    }
   }
+
+  m_picTargetBitInGOP = new int[numPic];
+  double totalPicRatio = 0;
+  double currPicRatio = 0;
   for ( i=0; i<numPic; i++ )
   {
-    currPicRatio = encRCSeq->getBitRatio( i );
+    totalPicRatio += encRCSeq->getBitRatio( i ) * m_picComplexityWeight[i];
+  }
+  for ( i=0; i<numPic; i++ )
+  {
+    currPicRatio = encRCSeq->getBitRatio( i ) * m_picComplexityWeight[i];
     m_picTargetBitInGOP[i] = (int)( ((double)targetBits) * currPicRatio / totalPicRatio );
   }
 
@@ -382,6 +437,7 @@ void EncRCGOP::create( EncRCSeq* encRCSeq, int numPic )
   m_targetBits   = targetBits;
   m_picLeft      = m_numPic;
   m_bitsLeft     = m_targetBits;
+  m_lookaheadCost = lookaheadCost;
 }
 
 void EncRCGOP::xCalEquaCoeff( EncRCSeq* encRCSeq, double* lambdaRatio, double* equaCoeffA, double* equaCoeffB, int GOPSize )
@@ -438,6 +494,11 @@ void EncRCGOP::destroy()
     delete[] m_picTargetBitInGOP;
     m_picTargetBitInGOP = NULL;
   }
+  if ( m_picComplexityWeight != NULL )
+  {
+    delete[] m_picComplexityWeight;
+    m_picComplexityWeight = NULL;
+  }
 }
 
 void EncRCGOP::updateAfterPicture( int bitsCost )
@@ -484,6 +545,7 @@ EncRCPic::EncRCPic()
   m_picActualBits       = 0;
   m_picQP               = 0;
   m_picLambda           = 0.0;
+  m_lookaheadCost       = 0.0;
 }
 
 EncRCPic::~EncRCPic()
@@ -498,11 +560,11 @@ int EncRCPic::xEstPicTargetBits( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP )
 
   int i;
   int currPicPosition = encRCGOP->getNumPic()-encRCGOP->getPicLeft();
-  int currPicRatio    = encRCSeq->getBitRatio( currPicPosition );
-  int totalPicRatio   = 0;
+  double currPicRatio  = encRCSeq->getBitRatio( currPicPosition ) * encRCGOP->getPicComplexityWeight( currPicPosition );
+  double totalPicRatio = 0;
   for ( i=currPicPosition; i<encRCGOP->getNumPic(); i++ )
   {
-    totalPicRatio += encRCSeq->getBitRatio( i );
+    totalPicRatio += encRCSeq->getBitRatio( i ) * encRCGOP->getPicComplexityWeight( i );
   }
 
   targetBits  = int( ((double)GOPbitsLeft) * currPicRatio / totalPicRatio );
@@ -544,6 +606,53 @@ int EncRCPic::xEstPicHeaderBits( list<EncRCPic*>& listPreviousPictures, int fram
   return estHeaderBits;
 }
 
+double EncRCPic::xEstComplexityRatio( list<EncRCPic*>& listPreviousPictures )
+{
+  if ( m_lookaheadCost <= 0.0 )
+  {
+    return 1.0;
+  }
+
+  // the R-lambda model of the last picture of the same level reflects the complexity of that picture
+  EncRCPic* refPic = NULL;
+  list<EncRCPic*>::iterator it;
+  for ( it = listPreviousPictures.begin(); it != listPreviousPictures.end(); it++ )
+  {
+    if ( (*it)->getFrameLevel() == m_frameLevel && (*it)->getLookaheadCost() > 0.0 )
+    {
+      refPic = *it;
+    }
+  }
+
+  const double minCostPerPixel = 0.25;    // keeps the ratios stable in almost static areas
+  const double picCost         = m_lookaheadCost + minCostPerPixel * m_numberOfPixel;
+  double picRatio = 1.0;
+  if ( refPic != NULL )
+  {
+    picRatio = Clip3( g_RCLookaheadMinRatio, g_RCLookaheadMaxRatio, picCost / ( refPic->getLookaheadCost() + minCostPerPixel * m_numberOfPixel ) );
+  }
+
+  for ( int i=0; i<m_numberOfLCU; i++ )
+  {
+    const double LCUCost = m_LCUs[i].m_lookaheadCost + minCostPerPixel * m_LCUs[i].m_numberOfPixel;
+    double LCURatio = 1.0;
+    if ( m_encRCSeq->getUseLCUSeparateModel() )
+    {
+      if ( refPic != NULL )
+      {
+        LCURatio = LCUCost / ( refPic->getLCU( i ).m_lookaheadCost + minCostPerPixel * m_LCUs[i].m_numberOfPixel );
+      }
+    }
+    else
+    {
+      LCURatio = picRatio * ( LCUCost / m_LCUs[i].m_numberOfPixel ) / ( picCost / m_numberOfPixel );
+    }
+    m_LCUs[i].m_complexityRatio = Clip3( g_RCLookaheadMinRatio, g_RCLookaheadMaxRatio, LCURatio );
+  }
+
+  return picRatio;
+}
+
 #if V0078_ADAPTIVE_LOWER_BOUND
 int EncRCPic::xEstPicLowerBound(EncRCSeq* encRCSeq, EncRCGOP* encRCGOP)
 {
@@ -597,7 +706,7 @@ void EncRCPic::addToPictureLsit( list<EncRCPic*>& listPreviousPictures )
   listPreviousPictures.push_back( this );
 }
 
-void EncRCPic::create( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP, int frameLevel, list<EncRCPic*>& listPreviousPictures )
+void EncRCPic::create( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP, int frameLevel, list<EncRCPic*>& listPreviousPictures, const std::vector<double>& lookaheadCostCtu )
 {
   destroy();
   m_encRCSeq = encRCSeq;
@@ -606,6 +715,12 @@ void EncRCPic::create( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP, int frameLevel, l
   int targetBits    = xEstPicTargetBits( encRCSeq, encRCGOP );
   int estHeaderBits = xEstPicHeaderBits( listPreviousPictures, frameLevel );
 
+  m_lookaheadCost = 0.0;
+  for ( int i=0; i<(int)lookaheadCostCtu.size(); i++ )
+  {
+    m_lookaheadCost += lookaheadCostCtu[i];
+  }
+
   if ( targetBits < estHeaderBits + 100 )
   {
     targetBits = estHeaderBits + 100;   // at least allocate 100 bits for picture data
@@ -645,6 +760,8 @@ void EncRCPic::create( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP, int frameLevel, l
       m_LCUs[LCUIdx].m_lambda     = 0.0;
       m_LCUs[LCUIdx].m_targetBits = 0;
       m_LCUs[LCUIdx].m_bitWeight  = 1.0;
+      m_LCUs[LCUIdx].m_lookaheadCost   = LCUIdx < (int)lookaheadCostCtu.size() ? lookaheadCostCtu[LCUIdx] : 0.0;
+      m_LCUs[LCUIdx].m_complexityRatio = 1.0;
       int currWidth  = ( (i == picWidthInLCU -1) ? picWidth  - LCUWidth *(picWidthInLCU -1) : LCUWidth  );
       int currHeight = ( (j == picHeightInLCU-1) ? picHeight - LCUHeight*(picHeightInLCU-1) : LCUHeight );
       m_LCUs[LCUIdx].m_numberOfPixel = currWidth * currHeight;
@@ -680,7 +797,7 @@ double EncRCPic::estimatePicLambda( list<EncRCPic*>& listPreviousPictures, Slice
   }
   else
   {
-    estLambda = alpha * pow( bpp, beta );
+    estLambda = alpha * pow( bpp / xEstComplexityRatio( listPreviousPictures ), beta );
   }
 
   double lastLevelLambda = -1.0;
@@ -745,7 +862,7 @@ double EncRCPic::estimatePicLambda( list<EncRCPic*>& listPreviousPictures, Slice
       betaLCU  = m_encRCSeq->getPicPara( m_frameLevel ).m_beta;
     }
 
-    m_LCUs[i].m_bitWeight =  m_LCUs[i].m_numberOfPixel * pow( estLambda/alphaLCU, 1.0/betaLCU );
+    m_LCUs[i].m_bitWeight =  m_LCUs[i].m_numberOfPixel * pow( estLambda/alphaLCU, 1.0/betaLCU ) * m_LCUs[i].m_complexityRatio;
 
     if ( m_LCUs[i].m_bitWeight < 0.01 )
     {
@@ -861,7 +978,7 @@ double EncRCPic::getLCUEstLambda( double bpp )
     beta  = m_encRCSeq->getPicPara( m_frameLevel ).m_beta;
   }
 
-  double estLambda = alpha * pow( bpp, beta );
+  double estLambda = alpha * pow( bpp / m_LCUs[LCUIdx].m_complexityRatio, beta );
   //for Lambda clip, picture level clip
   double clipPicLambda = m_estPicLambda;
 
@@ -1431,16 +1548,16 @@ void RateCtrl::init( int totalFrames, int targetBitrate, int frameRate, int GOPS
   delete[] GOPID2Level;
 }
 
-void RateCtrl::initRCPic( int frameLevel )
+void RateCtrl::initRCPic( int frameLevel, const std::vector<double>& lookaheadCostCtu )
 {
   m_encRCPic = new EncRCPic;
-  m_encRCPic->create( m_encRCSeq, m_encRCGOP, frameLevel, m_listRCPictures );
+  m_encRCPic->create( m_encRCSeq, m_encRCGOP, frameLevel, m_listRCPictures, lookaheadCostCtu );
 }
 
-void RateCtrl::initRCGOP( int numberOfPictures )
+void RateCtrl::initRCGOP( int numberOfPictures, const std::vector<double>& picLookaheadCost )
 {
   m_encRCGOP = new EncRCGOP;
-  m_encRCGOP->create( m_encRCSeq, numberOfPictures );
+  m_encRCGOP->create( m_encRCSeq, numberOfPictures, picLookaheadCost );
 }
 
 #if U0132_TARGET_BITS_SATURATION
@@ -69,6 +69,9 @@ const double g_RCAlphaMinValue = 0.05;
 const double g_RCAlphaMaxValue = 500.0;
 const double g_RCBetaMinValue  = -3.0;
 const double g_RCBetaMaxValue  = -0.1;
+const double g_RCLookaheadMinRatio    = 0.25;
+const double g_RCLookaheadMaxRatio    = 4.0;
+const double g_RCLookaheadHistWeight  = 0.5;
 
 #define ALPHA     6.7542;
 #define BETA1     1.2517
@@ -84,6 +87,8 @@ struct TRCLCU
   int m_numberOfPixel;
   double m_costIntra;
   int m_targetBitsLeft;
+  double m_lookaheadCost;     // complexity from the lookahead pre-analysis, 0 if not available
+  double m_complexityRatio;   // lookahead complexity relative to the R-lambda model of this LCU
 };
 
 struct TRCParameter
@@ -148,6 +153,9 @@ public:
   double getLastLambda()                { return m_lastLambda;   }
   void   setLastLambda( double lamdba ) { m_lastLambda = lamdba; }
 
+  double getLookaheadCost()             { return m_lookaheadCost; }
+  void   updateLookaheadCost( double cost );
+
 private:
   int m_totalFrames;
   int m_targetRate;
@@ -177,6 +185,7 @@ private:
 
   int m_adaptiveBit;
   double m_lastLambda;
+  double m_lookaheadCost;   // smoothed per-picture lookahead complexity of the previous GOPs
 };
 
 class EncRCGOP
@@ -186,7 +195,7 @@ public:
   ~EncRCGOP();
 
 public:
-  void create( EncRCSeq* encRCSeq, int numPic );
+  void create( EncRCSeq* encRCSeq, int numPic, const std::vector<double>& picLookaheadCost = std::vector<double>() );
   void destroy();
   void updateAfterPicture( int bitsCost );
 
@@ -202,14 +211,18 @@ public:
   int  getPicLeft()               { return m_picLeft; }
   int  getBitsLeft()              { return m_bitsLeft; }
   int  getTargetBitInGOP( int i ) { return m_picTargetBitInGOP[i]; }
+  double getLookaheadCost()       { return m_lookaheadCost; }
+  double getPicComplexityWeight( int i ) { return m_picComplexityWeight[i]; }
 
 private:
   EncRCSeq* m_encRCSeq;
   int* m_picTargetBitInGOP;
+  double* m_picComplexityWeight;   // lookahead weight of the bit ratio of each picture in coding order, 1 if not available
   int m_numPic;
   int m_targetBits;
   int m_picLeft;
   int m_bitsLeft;
+  double m_lookaheadCost;   // average per-picture lookahead complexity of this GOP, 0 if not available
 };
 
 class EncRCPic
@@ -219,7 +232,7 @@ public:
   ~EncRCPic();
 
 public:
-  void create( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP, int frameLevel, list<EncRCPic*>& listPreviousPictures );
+  void create( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP, int frameLevel, list<EncRCPic*>& listPreviousPictures, const std::vector<double>& lookaheadCostCtu );
   void destroy();
 
   int    estimatePicQP    ( double lambda, list<EncRCPic*>& listPreviousPictures );
@@ -244,6 +257,7 @@ public:
 private:
   int xEstPicTargetBits( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP );
   int xEstPicHeaderBits( list<EncRCPic*>& listPreviousPictures, int frameLevel );
+  double xEstComplexityRatio( list<EncRCPic*>& listPreviousPictures );
 #if V0078_ADAPTIVE_LOWER_BOUND
   int xEstPicLowerBound( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP );
 #endif
@@ -268,6 +282,7 @@ public:
   TRCLCU* getLCU()                                        { return m_LCUs; }
   TRCLCU& getLCU( int LCUIdx )                            { return m_LCUs[LCUIdx]; }
   int  getPicActualHeaderBits()                           { return m_picActualHeaderBits; }
+  double getLookaheadCost()                               { return m_lookaheadCost; }
 #if U0132_TARGET_BITS_SATURATION
   void setBitLeft(int bits)                               { m_bitsLeft = bits; }
 #endif
@@ -309,6 +324,7 @@ private:
   int m_picActualBits;          // the whole picture, including header
   int m_picQP;                  // in integer form
   double m_picLambda;
+  double m_lookaheadCost;       // lookahead complexity of the whole picture, 0 if not available
 };
 
 class RateCtrl
@@ -320,8 +336,8 @@ public:
 public:
   void init( int totalFrames, int targetBitrate, int frameRate, int GOPSize, int picWidth, int picHeight, int LCUWidth, int LCUHeight, int keepHierBits, bool useLCUSeparateModel, GOPEntry GOPList[MAX_GOP] );
   void destroy();
-  void initRCPic( int frameLevel );
-  void initRCGOP( int numberOfPictures );
+  void initRCPic( int frameLevel, const std::vector<double>& lookaheadCostCtu );
+  void initRCGOP( int numberOfPictures, const std::vector<double>& picLookaheadCost = std::vector<double>() );
   void destroyRCGOP();
 
 public:
@@ -560,12 +560,13 @@ void HLSWriter::codeSPSNext( const SPSNext& spsNext, const bool usePCM )
 #endif
 #if JVET_K_AFFINE
   WRITE_FLAG( spsNext.getUseAffine() ? 1 : 0,                                                   "affine_flag" );
-#if JVET_K0337_AFFINE_6PARA
   if ( spsNext.getUseAffine() )
   {
+#if JVET_K0337_AFFINE_6PARA
 	  WRITE_UVLC( spsNext.getUseAffineType(),                                                   "affine_type_flag" );
-  }
 #endif
+	  WRITE_FLAG( spsNext.getUseAffineAdaptiveSubblock() ? 1 : 0,                               "affine_adaptive_subblock_flag" );
+  }
 #endif
 
   for( int k = 0; k < SPSNext::NumReservedFlags; k++ )
@@ -1673,7 +1674,7 @@ void HLSWriter::alfFilter( const AlfSliceParam& alfSliceParam, const bool isChro
     }
   }
 
-  static int bitsCoeffScan[EncAdaptiveLoopFilter::m_MAX_SCAN_VAL][EncAdaptiveLoopFilter::m_MAX_EXP_GOLOMB];
+  int bitsCoeffScan[EncAdaptiveLoopFilter::m_MAX_SCAN_VAL][EncAdaptiveLoopFilter::m_MAX_EXP_GOLOMB];
   memset( bitsCoeffScan, 0, sizeof( bitsCoeffScan ) );
   AlfFilterShape alfShape( isChroma ? 5 : ( alfSliceParam.lumaFilterType == ALF_FILTER_5 ? 5 : 7 ) );
   const int maxGolombIdx = AdaptiveLoopFilter::getMaxGolombIdx( alfShape.filterType );
@@ -1697,7 +1698,7 @@ void HLSWriter::alfFilter( const AlfSliceParam& alfSliceParam, const bool isChro
     }
   }
 
-  static int kMinTab[MAX_NUM_ALF_COEFF];
+  int kMinTab[MAX_NUM_ALF_COEFF];
   int kMin = EncAdaptiveLoopFilter::getGolombKMin( alfShape, numFilters, kMinTab, bitsCoeffScan );
 
   // Golomb parameters